@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Non-allocating callable toolkit shared by the optimized pattern examples
+//
+// FunctionRef<R(Args...)>         - non-owning view of a callable or plain
+//                                   function; two pointers, for synchronous
+//                                   callbacks that do not outlive the call they
+//                                   are passed to
+// InplaceFunction<R(Args...), N>  - owning, copyable callable stored in an
+//                                   N-byte inline buffer; never allocates by
+//                                   itself and rejects oversized callables at
+//                                   compile time
+//
+// Both accept any callable, including std::function, so existing call sites
+// that pass a std::function keep compiling. A wrapped std::function still
+// allocates whenever it copies its own target. Null function pointers and
+// empty std::functions give an empty wrapper that throws
+// std::bad_function_call when invoked.
+
+namespace callable_detail {
+
+// Null function pointers and empty std::function objects become empty wrappers
+template<typename F>
+bool isNull(const F& f) noexcept {
+    if constexpr (std::is_function_v<F>) {
+        return false; // a function reference always names a function
+    } else if constexpr (std::is_pointer_v<F> || std::is_member_pointer_v<F>) {
+        return f == nullptr;
+    } else if constexpr (std::is_constructible_v<bool, const F&> &&
+                         !std::is_arithmetic_v<F>) {
+        return !static_cast<bool>(f);
+    } else {
+        return false;
+    }
+}
+
+} // namespace callable_detail
+
+template<typename Signature>
+class FunctionRef;
+
+template<typename R, typename... Args>
+class FunctionRef<R(Args...)> {
+    // Function pointers cannot portably round-trip through void*
+    union Target {
+        void* object;
+        void (*function)();
+    };
+
+    template<typename F>
+    static constexpr bool isFunctionPointer =
+        std::is_function_v<std::remove_pointer_t<std::decay_t<F>>>;
+
+public:
+    // Callable objects are referenced; they must outlive the FunctionRef
+    template<typename F, typename = std::enable_if_t<
+        !std::is_same_v<std::decay_t<F>, FunctionRef> &&
+        !isFunctionPointer<F> &&
+        std::is_invocable_r_v<R, F&, Args...>>>
+    FunctionRef(F&& f) noexcept
+        : callback_([](Target target, Args... args) -> R {
+              return std::invoke(*static_cast<std::add_pointer_t<F>>(target.object),
+                                 std::forward<Args>(args)...);
+          }) {
+        target_.object = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+        if (callable_detail::isNull(f)) {
+            callback_ = &callEmpty;
+        }
+    }
+
+    // Plain functions, by name or pointer, are stored by value
+    template<typename F, typename = std::enable_if_t<
+        std::is_function_v<F> && std::is_invocable_r_v<R, F&, Args...>>>
+    FunctionRef(F* function) noexcept
+        : callback_([](Target target, Args... args) -> R {
+              return std::invoke(reinterpret_cast<F*>(target.function),
+                                 std::forward<Args>(args)...);
+          }) {
+        target_.function = reinterpret_cast<void (*)()>(function);
+        if (!function) {
+            callback_ = &callEmpty;
+        }
+    }
+
+    FunctionRef(const FunctionRef&) noexcept = default;
+    FunctionRef& operator=(const FunctionRef&) noexcept = default;
+
+    R operator()(Args... args) const {
+        return callback_(target_, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept {
+        return callback_ != &callEmpty;
+    }
+
+private:
+    static R callEmpty(Target, Args...) {
+        throw std::bad_function_call();
+    }
+
+    Target target_;
+    R (*callback_)(Target, Args...);
+};
+
+template<typename Signature, std::size_t Capacity = 48>
+class InplaceFunction;
+
+template<typename R, typename... Args, std::size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> {
+    struct Ops {
+        void (*copy)(void* dst, const void* src);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void* object) noexcept;
+    };
+
+    template<typename F>
+    struct OpsFor {
+        static R invoke(void* object, Args... args) {
+            return std::invoke(*static_cast<F*>(object), std::forward<Args>(args)...);
+        }
+
+        static void copy(void* dst, const void* src) {
+            ::new (dst) F(*static_cast<const F*>(src));
+        }
+
+        static void move(void* dst, void* src) noexcept {
+            ::new (dst) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        }
+
+        static void destroy(void* object) noexcept {
+            static_cast<F*>(object)->~F();
+        }
+
+        static constexpr Ops table{&copy, &move, &destroy};
+    };
+
+public:
+    static constexpr std::size_t capacity = Capacity;
+
+    InplaceFunction() noexcept = default;
+    InplaceFunction(std::nullptr_t) noexcept {}
+
+    template<typename F, typename D = std::decay_t<F>, typename = std::enable_if_t<
+        !std::is_same_v<D, InplaceFunction> &&
+        std::is_invocable_r_v<R, D&, Args...>>>
+    InplaceFunction(F&& f) {
+        static_assert(sizeof(D) <= Capacity, "Callable does not fit the inline buffer");
+        static_assert(alignof(D) <= alignof(std::max_align_t), "Callable is over-aligned");
+        static_assert(std::is_nothrow_move_constructible_v<D>, "Callable must be nothrow movable");
+        static_assert(std::is_copy_constructible_v<D>, "Callable must be copyable");
+        if (callable_detail::isNull(f)) {
+            return;
+        }
+        ::new (static_cast<void*>(storage_)) D(std::forward<F>(f));
+        invoke_ = &OpsFor<D>::invoke;
+        ops_ = &OpsFor<D>::table;
+    }
+
+    InplaceFunction(const InplaceFunction& other) {
+        if (other.ops_) {
+            other.ops_->copy(storage_, other.storage_);
+            invoke_ = other.invoke_;
+            ops_ = other.ops_;
+        }
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept {
+        moveFrom(other);
+    }
+
+    InplaceFunction& operator=(const InplaceFunction& other) {
+        if (this != &other) {
+            InplaceFunction copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    ~InplaceFunction() {
+        reset();
+    }
+
+    R operator()(Args... args) const {
+        if (!invoke_) {
+            throw std::bad_function_call();
+        }
+        return invoke_(const_cast<unsigned char*>(storage_), std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept {
+        return invoke_ != nullptr;
+    }
+
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+            invoke_ = nullptr;
+        }
+    }
+
+private:
+    void moveFrom(InplaceFunction& other) noexcept {
+        if (other.ops_) {
+            other.ops_->move(storage_, other.storage_);
+            invoke_ = other.invoke_;
+            ops_ = other.ops_;
+            other.invoke_ = nullptr;
+            other.ops_ = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[Capacity];
+    R (*invoke_)(void*, Args...) = nullptr;
+    const Ops* ops_ = nullptr;
+};
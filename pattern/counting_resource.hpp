@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+// Allocation-counting memory resource shared by the optimized examples
+//
+// Forwards every request to an upstream resource and counts it, so a
+// benchmark can report what one container allocated without replacing the
+// global operator new. Only allocations made through this resource are seen:
+// hand it to the containers being measured.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+        : upstream_(upstream) {}
+
+    CountingResource(const CountingResource&) = delete;
+    CountingResource& operator=(const CountingResource&) = delete;
+
+    [[nodiscard]] size_t allocations() const noexcept { return allocations_; }
+    [[nodiscard]] size_t bytesAllocated() const noexcept { return bytes_; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* memory = upstream_->allocate(bytes, alignment);
+        ++allocations_;
+        bytes_ += bytes;
+        return memory;
+    }
+
+    void do_deallocate(void* memory, size_t bytes, size_t alignment) override {
+        upstream_->deallocate(memory, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    size_t allocations_ = 0;
+    size_t bytes_ = 0;
+};
@@ -6,6 +6,8 @@
 #include <queue>
 #include <stack>
 
+#include "callable.hpp"
+
 // Optimized Command Pattern Example
 // Using modern C++17/20 features for better performance and type safety
 
@@ -244,11 +246,13 @@ private:
     std::stack<std::unique_ptr<Command>> redoStack_;
 };
 
-// Modern command using std::function
+// Modern command using inline callables
+// InplaceFunction (callable.hpp) never allocates; it also accepts a
+// std::function, so callers holding one can still pass it in.
 class FunctionalCommand {
 public:
-    using ExecuteFunc = std::function<void()>;
-    using UndoFunc = std::function<void()>;
+    using ExecuteFunc = InplaceFunction<void()>;
+    using UndoFunc = InplaceFunction<void()>;
     
     FunctionalCommand(ExecuteFunc execute, UndoFunc undo, std::string description)
         : execute_(std::move(execute))
@@ -485,5 +489,13 @@ int main() {
     addCommand.undo();
     std::cout << "After functional undo: " << funcCalc.getResult() << std::endl;
     
+    // std::function callers keep working
+    std::function<void()> doubleIt = [&funcCalc]() { funcCalc.multiply(2); };
+    std::function<void()> halveIt = [&funcCalc]() { funcCalc.divide(2); };
+    FunctionalCommand doubleCommand(doubleIt, halveIt, "Double");
+    funcCalc.setResult(21);
+    doubleCommand.execute();
+    doubleCommand.undo();
+    
     return 0;
 } 
\ No newline at end of file
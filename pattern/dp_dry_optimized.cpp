@@ -6,6 +6,8 @@
 #include <type_traits>
 #include <regex>
 
+#include "callable.hpp"
+
 // Optimized DRY (Don't Repeat Yourself) Principle Example
 // Using modern C++17/20 features for better performance and maintainability
 
@@ -88,11 +90,12 @@ public:
     }
 };
 
-// Modern validation framework using std::function and templates
+// Modern validation framework using inline callables and templates
 template<typename T>
 class ValidationRule {
 public:
-    using ValidatorFunc = std::function<bool(const T&)>;
+    // Stores the predicate inline; a std::function is accepted as well
+    using ValidatorFunc = InplaceFunction<bool(const T&)>;
     
     explicit ValidationRule(ValidatorFunc func, std::string errorMessage = "")
         : validator_(std::move(func)), errorMessage_(std::move(errorMessage)) {}
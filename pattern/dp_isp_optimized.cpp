@@ -5,6 +5,17 @@
 #include <functional>
 #include <type_traits>
 #include <numeric>
+#include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <tuple>
+#include <utility>
 
 // Optimized Interface Segregation Principle (ISP) Example
 // Using modern C++17/20 features for better performance and type safety
@@ -220,6 +231,303 @@ private:
     std::string model_;
 };
 
+// Work-stealing scheduler that treats Workable instances as task producers
+// - each available worker becomes one task per round, worth a number of
+//   work() quanta proportional to getWorkEfficiency()
+// - tasks are dealt round-robin, most efficient first, onto per-thread deques;
+//   owners pop from the front (highest weight), idle threads steal from the
+//   back of other deques (lowest weight, cheapest to move)
+// - canWork() gates dispatch, and canWork()/needsRest() are re-checked before
+//   every quantum so a tired worker stops early instead of being retried
+// A worker is only ever owned by one task per round, so work() is never
+// called concurrently on the same object.
+class WorkStealingScheduler {
+public:
+    struct Options {
+        size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        size_t quantaPerRound = 4; // quanta granted at efficiency 1.0
+    };
+    
+    struct RoundReport {
+        size_t dispatched = 0;   // workers that received a task
+        size_t unavailable = 0;  // skipped because canWork() was false
+        size_t rested = 0;       // stopped early on canWork()/needsRest()
+        size_t quanta = 0;       // work() calls made
+        size_t steals = 0;
+        double totalEfficiency = 0.0; // sum over dispatched workers
+    };
+    
+    WorkStealingScheduler() : WorkStealingScheduler(Options{}) {}
+    
+    explicit WorkStealingScheduler(Options options)
+        : options_(options), queues_(std::max<size_t>(1, options.threads)) {
+        threads_.reserve(queues_.size());
+        for (size_t i = 0; i < queues_.size(); ++i) {
+            threads_.emplace_back([this, i] { threadLoop(i); });
+        }
+    }
+    
+    ~WorkStealingScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(roundMutex_);
+            stopping_ = true;
+        }
+        roundStarted_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+    
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+    
+    [[nodiscard]] size_t threadCount() const noexcept {
+        return threads_.size();
+    }
+    
+    // Runs one round over the workers and blocks until every task finished
+    template<typename WorkerRange>
+    RoundReport runRound(const WorkerRange& workers) {
+        RoundReport report;
+        std::vector<Task> tasks;
+        tasks.reserve(std::size(workers));
+        for (const auto& worker : workers) {
+            Workable& workable = *worker;
+            if (!workable.canWork()) {
+                ++report.unavailable;
+                continue;
+            }
+            double efficiency = workable.getWorkEfficiency();
+            if (efficiency <= 0.0) {
+                ++report.unavailable;
+                continue;
+            }
+            auto quanta = static_cast<uint32_t>(std::max(1.0, std::round(efficiency * options_.quantaPerRound)));
+            // Cross-cast once per task; Workable itself has no rest signal
+            tasks.push_back({&workable, dynamic_cast<HumanNeeds*>(&workable), efficiency, quanta});
+            report.totalEfficiency += efficiency;
+        }
+        report.dispatched = tasks.size();
+        if (tasks.empty()) {
+            return report;
+        }
+        
+        std::stable_sort(tasks.begin(), tasks.end(),
+            [](const Task& a, const Task& b) { return a.efficiency > b.efficiency; });
+        // Counters are reset before any task is queued: a thread still
+        // draining its deques from the previous round may pick tasks up
+        // before it sees the new generation
+        rested_.store(0, std::memory_order_relaxed);
+        quanta_.store(0, std::memory_order_relaxed);
+        steals_.store(0, std::memory_order_relaxed);
+        pending_.store(tasks.size(), std::memory_order_relaxed);
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            Queue& queue = queues_[i % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(tasks[i]);
+        }
+        {
+            std::lock_guard<std::mutex> lock(roundMutex_);
+            ++generation_;
+        }
+        roundStarted_.notify_all();
+        
+        std::unique_lock<std::mutex> lock(roundMutex_);
+        roundFinished_.wait(lock, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+        report.rested = rested_.load(std::memory_order_relaxed);
+        report.quanta = quanta_.load(std::memory_order_relaxed);
+        report.steals = steals_.load(std::memory_order_relaxed);
+        return report;
+    }
+
+private:
+    struct Task {
+        Workable* worker;
+        HumanNeeds* needs; // null for workers that never rest
+        double efficiency;
+        uint32_t quanta;
+    };
+    
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+    
+    bool popOwn(size_t self, Task& task) {
+        Queue& queue = queues_[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        return true;
+    }
+    
+    bool steal(size_t self, Task& task) {
+        for (size_t offset = 1; offset < queues_.size(); ++offset) {
+            Queue& victim = queues_[(self + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void execute(const Task& task) {
+        size_t done = 0;
+        for (; done < task.quanta; ++done) {
+            if (!task.worker->canWork() || (task.needs && task.needs->needsRest())) {
+                rested_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            task.worker->work();
+        }
+        quanta_.fetch_add(done, std::memory_order_relaxed);
+    }
+    
+    void threadLoop(size_t self) {
+        uint64_t seenGeneration = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(roundMutex_);
+                roundStarted_.wait(lock, [&] { return stopping_ || generation_ != seenGeneration; });
+                if (stopping_) {
+                    return;
+                }
+                seenGeneration = generation_;
+            }
+            // All tasks are queued before the round starts, so once every
+            // deque is empty this thread has nothing left to do this round
+            Task task{};
+            for (;;) {
+                if (!popOwn(self, task)) {
+                    if (!steal(self, task)) {
+                        break;
+                    }
+                    steals_.fetch_add(1, std::memory_order_relaxed);
+                }
+                execute(task);
+                if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lock(roundMutex_);
+                    roundFinished_.notify_one();
+                }
+            }
+        }
+    }
+    
+    Options options_;
+    std::vector<Queue> queues_;
+    std::vector<std::thread> threads_;
+    
+    std::mutex roundMutex_;
+    std::condition_variable roundStarted_;
+    std::condition_variable roundFinished_;
+    uint64_t generation_ = 0;
+    bool stopping_ = false;
+    
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> rested_{0};
+    std::atomic<size_t> quanta_{0};
+    std::atomic<size_t> steals_{0};
+};
+
+// Registry that owns each worker once and slices it by interface
+// add() records the worker's interface pointers in one dense vector per
+// interface it implements, using static conversions worked out at compile
+// time. Role-wide sweeps then walk a contiguous pointer array with no
+// dynamic_cast and no per-role ownership, so a HumanDeveloper can appear in
+// the human, compensation and technical sweeps at the same time.
+class WorkerRegistry {
+public:
+    template<typename WorkerType>
+    WorkerType& add(std::unique_ptr<WorkerType> worker) {
+        WorkerType* raw = worker.get();
+        // Make room in every container before touching any of them, so a
+        // throwing allocation leaves the registry unchanged and worker still
+        // owning the object; the push_backs below then cannot throw
+        constexpr auto indices = std::make_index_sequence<std::tuple_size_v<Slices>>{};
+        reserveSlices<WorkerType>(indices);
+        reserveOneMore(owned_);
+        owned_.emplace_back(nullptr, [](void* object) {
+            delete static_cast<WorkerType*>(object);
+        });
+        owned_.back().reset(worker.release());
+        registerSlices(raw, indices);
+        return *raw;
+    }
+    
+    template<typename WorkerType, typename... Args>
+    WorkerType& emplace(Args&&... args) {
+        return add(std::make_unique<WorkerType>(std::forward<Args>(args)...));
+    }
+    
+    // Every registered worker implementing Interface, in registration order
+    template<typename Interface>
+    [[nodiscard]] const std::vector<Interface*>& slice() const noexcept {
+        return std::get<std::vector<Interface*>>(slices_);
+    }
+    
+    template<typename Interface, typename Func>
+    void forEach(Func&& func) const {
+        for (Interface* object : slice<Interface>()) {
+            func(*object);
+        }
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return owned_.size();
+    }
+    
+    void reserve(size_t count) {
+        owned_.reserve(count);
+    }
+
+private:
+    using Slices = std::tuple<
+        std::vector<Workable*>, std::vector<HumanNeeds*>, std::vector<Compensable*>,
+        std::vector<Communicative*>, std::vector<TechnicalWorker*>,
+        std::vector<Designer*>, std::vector<Manager*>>;
+    
+    template<typename WorkerType, size_t... I>
+    void reserveSlices(std::index_sequence<I...>) {
+        (reserveSlice<WorkerType>(std::get<I>(slices_)), ...);
+    }
+    
+    template<typename WorkerType, typename Interface>
+    static void reserveSlice(std::vector<Interface*>& slice) {
+        if constexpr (std::is_base_of_v<Interface, WorkerType>) {
+            reserveOneMore(slice);
+        }
+    }
+    
+    // Grows geometrically, like push_back would, to keep add() amortized O(1)
+    template<typename Vector>
+    static void reserveOneMore(Vector& vector) {
+        if (vector.size() == vector.capacity()) {
+            vector.reserve(std::max<size_t>(8, vector.capacity() * 2));
+        }
+    }
+    
+    template<typename WorkerType, size_t... I>
+    void registerSlices(WorkerType* worker, std::index_sequence<I...>) {
+        (registerSlice(worker, std::get<I>(slices_)), ...);
+    }
+    
+    template<typename WorkerType, typename Interface>
+    static void registerSlice(WorkerType* worker, std::vector<Interface*>& slice) {
+        if constexpr (std::is_base_of_v<Interface, WorkerType>) {
+            slice.push_back(worker);
+        }
+    }
+    
+    std::vector<std::unique_ptr<void, void (*)(void*)>> owned_;
+    Slices slices_;
+};
+
 // Modern worker manager using segregated interfaces
 class WorkerManager {
 public:
@@ -238,6 +546,12 @@ public:
             });
     }
     
+    // Dispatch one efficiency-weighted round across the scheduler's threads;
+    // the report's totalEfficiency covers the workers that were dispatched
+    WorkStealingScheduler::RoundReport processWork(WorkStealingScheduler& scheduler) const {
+        return scheduler.runRound(workers_);
+    }
+    
     // Calculate total efficiency
     [[nodiscard]] double getTotalEfficiency() const {
         return std::accumulate(workers_.begin(), workers_.end(), 0.0,
@@ -272,10 +586,113 @@ public:
             });
     }
 
+    // Registry-backed sweeps: one contiguous interface slice per role
+    void handleHumanNeeds(const WorkerRegistry& registry) {
+        registry.forEach<HumanNeeds>([](HumanNeeds& human) {
+            if (human.needsRest()) {
+                human.sleep();
+            }
+        });
+    }
+    
+    void processCompensation(const WorkerRegistry& registry) {
+        registry.forEach<Compensable>([](Compensable& employee) { employee.getPaid(); });
+    }
+    
+    void technicalWorkSession(const WorkerRegistry& registry) {
+        registry.forEach<TechnicalWorker>([](TechnicalWorker& dev) {
+            dev.writeCode();
+            dev.test();
+            dev.debug();
+        });
+    }
+
 private:
     std::vector<std::unique_ptr<Workable>> workers_;
 };
 
+// Simulated worker for scheduler benchmarks: fixed compute per quantum,
+// tires after a number of quanta and recovers on sleep()
+class SimulatedWorker : public Workable, public HumanNeeds {
+public:
+    SimulatedWorker(double efficiency, uint32_t costPerQuantum, uint32_t stamina)
+        : efficiency_(efficiency), cost_(costPerQuantum), stamina_(stamina) {}
+    
+    [[nodiscard]] bool canWork() const override { return fatigue_ < stamina_; }
+    void work() override {
+        uint64_t x = state_;
+        for (uint32_t i = 0; i < cost_; ++i) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+        state_ = x;
+        ++fatigue_;
+    }
+    [[nodiscard]] double getWorkEfficiency() const override { return efficiency_; }
+    
+    void eat() override { fatigue_ = 0; }
+    void sleep() override { fatigue_ = 0; }
+    void takeVacation() override { fatigue_ = 0; }
+    [[nodiscard]] bool needsRest() const override { return fatigue_ >= stamina_; }
+
+private:
+    double efficiency_;
+    uint32_t cost_;
+    uint32_t stamina_;
+    uint32_t fatigue_ = 0;
+    uint64_t state_ = 1;
+};
+
+// Silent workers for role-sweep benchmarks
+class QuietDeveloper : public Workable, public HumanNeeds,
+                       public Compensable, public TechnicalWorker {
+public:
+    QuietDeveloper(double salary, bool tired) : salary_(salary), needsRest_(tired) {}
+    
+    [[nodiscard]] bool canWork() const override { return !needsRest_; }
+    void work() override { needsRest_ = true; }
+    [[nodiscard]] double getWorkEfficiency() const override { return needsRest_ ? 0.5 : 1.0; }
+    
+    void eat() override { needsRest_ = false; }
+    void sleep() override { needsRest_ = false; }
+    void takeVacation() override { needsRest_ = false; }
+    [[nodiscard]] bool needsRest() const override { return needsRest_; }
+    
+    void getPaid() override { ++paychecks_; }
+    [[nodiscard]] double getSalary() const override { return salary_; }
+    void requestRaise() override { salary_ *= 1.01; }
+    
+    void writeCode() override { ++commits_; }
+    void debug() override {}
+    void test() override {}
+    [[nodiscard]] std::string getProgrammingLanguage() const override { return "C++"; }
+
+private:
+    double salary_;
+    bool needsRest_;
+    uint32_t paychecks_ = 0;
+    uint32_t commits_ = 0;
+};
+
+class QuietRobot : public Workable, public TechnicalWorker, public Designer {
+public:
+    [[nodiscard]] bool canWork() const override { return true; }
+    void work() override { ++cycles_; }
+    [[nodiscard]] double getWorkEfficiency() const override { return 1.0; }
+    
+    void writeCode() override { ++commits_; }
+    void debug() override {}
+    void test() override {}
+    [[nodiscard]] std::string getProgrammingLanguage() const override { return "C++"; }
+    
+    void designSystem() override {}
+    void createPrototype() override {}
+    [[nodiscard]] std::string getDesignTool() const override { return "AI Design Suite"; }
+
+private:
+    uint32_t cycles_ = 0;
+    uint32_t commits_ = 0;
+};
+
 // Template-based worker factory for compile-time type safety
 template<typename WorkerType>
 class WorkerFactory {
@@ -314,6 +731,16 @@ int main() {
     
     std::cout << "\nTotal efficiency: " << manager.getTotalEfficiency() << std::endl;
     
+    // Same workers through the work-stealing scheduler
+    std::cout << "\nScheduled work session:" << std::endl;
+    {
+        WorkStealingScheduler scheduler(WorkStealingScheduler::Options{1, 2});
+        auto report = manager.processWork(scheduler);
+        std::cout << "Dispatched " << report.dispatched << ", unavailable " << report.unavailable
+                  << ", rested " << report.rested << ", quanta " << report.quanta
+                  << ", efficiency " << report.totalEfficiency << std::endl;
+    }
+    
     // Demonstrate specific interface usage
     auto alice = WorkerFactory<HumanDeveloper>::create("Alice", 75000.0, "C++");
     auto robo = WorkerFactory<Robot>::create("RoboDev-3000");
@@ -343,5 +770,161 @@ int main() {
     std::cout << "\nAlice's language: " << alice->getProgrammingLanguage() << std::endl;
     std::cout << "Robot's language: " << robo->getProgrammingLanguage() << std::endl;
     
+    // Registry: one owner, several role slices
+    std::cout << "\nRegistry sweeps:" << std::endl;
+    {
+        WorkerRegistry registry;
+        registry.emplace<HumanDeveloper>("Bob", 80000.0, "Rust");
+        registry.emplace<Robot>("RoboDev-4000");
+        std::cout << "Workers: " << registry.size()
+                  << ", humans: " << registry.slice<HumanNeeds>().size()
+                  << ", technical: " << registry.slice<TechnicalWorker>().size()
+                  << ", designers: " << registry.slice<Designer>().size() << std::endl;
+        manager.processCompensation(registry);
+        manager.technicalWorkSession(registry);
+    }
+    
+    // Role sweeps over 1e6 workers: dynamic_cast filtering vs registry slices
+    std::cout << "\n--- Role Sweep Benchmark ---" << std::endl;
+    {
+        constexpr size_t workerCount = 1'000'000;
+        constexpr int sweeps = 5;
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> salaryDist(40'000.0, 160'000.0);
+        
+        // Without a registry, mixed workers live in one owning list and
+        // every role sweep has to discover the interface at run time
+        std::vector<std::unique_ptr<Workable>> mixed;
+        mixed.reserve(workerCount);
+        WorkerRegistry registry;
+        registry.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i) {
+            bool human = rng() % 2 == 0;
+            double salary = salaryDist(rng);
+            bool tired = rng() % 3 == 0;
+            if (human) {
+                mixed.push_back(std::make_unique<QuietDeveloper>(salary, tired));
+                registry.emplace<QuietDeveloper>(salary, tired);
+            } else {
+                mixed.push_back(std::make_unique<QuietRobot>());
+                registry.emplace<QuietRobot>();
+            }
+        }
+        
+        auto msSince = [](auto start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+        
+        double payroll = 0.0;
+        size_t tired = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int sweep = 0; sweep < sweeps; ++sweep) {
+            for (const auto& worker : mixed) {
+                if (auto* employee = dynamic_cast<Compensable*>(worker.get())) {
+                    payroll += employee->getSalary();
+                }
+            }
+            for (const auto& worker : mixed) {
+                if (auto* human = dynamic_cast<HumanNeeds*>(worker.get())) {
+                    tired += human->needsRest();
+                }
+            }
+            for (const auto& worker : mixed) {
+                if (auto* dev = dynamic_cast<TechnicalWorker*>(worker.get())) {
+                    dev->writeCode();
+                }
+            }
+        }
+        double castMs = msSince(start) / sweeps;
+        
+        double registryPayroll = 0.0;
+        size_t registryTired = 0;
+        start = std::chrono::steady_clock::now();
+        for (int sweep = 0; sweep < sweeps; ++sweep) {
+            registry.forEach<Compensable>([&](Compensable& employee) { registryPayroll += employee.getSalary(); });
+            registry.forEach<HumanNeeds>([&](HumanNeeds& human) { registryTired += human.needsRest(); });
+            registry.forEach<TechnicalWorker>([](TechnicalWorker& dev) { dev.writeCode(); });
+        }
+        double registryMs = msSince(start) / sweeps;
+        
+        std::cout << workerCount << " workers, 3 role sweeps: dynamic_cast " << castMs
+                  << " ms, registry slices " << registryMs << " ms"
+                  << ((payroll == registryPayroll && tired == registryTired) ? "" : " (result mismatch)")
+                  << std::endl;
+    }
+    
+    // Scheduler throughput: thousands of simulated workers of mixed efficiency
+    std::cout << "\n--- Scheduler Throughput Benchmark ---" << std::endl;
+    {
+        constexpr size_t workerCount = 20'000;
+        constexpr int rounds = 10;
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> efficiencyDist(0.25, 2.0);
+        std::uniform_int_distribution<uint32_t> costDist(200, 3'000);
+        std::uniform_int_distribution<uint32_t> staminaDist(2, 12);
+        
+        auto makeManager = [&](std::vector<SimulatedWorker*>& handles) {
+            rng.seed(42);
+            WorkerManager benchManager;
+            handles.clear();
+            for (size_t i = 0; i < workerCount; ++i) {
+                auto worker = std::make_unique<SimulatedWorker>(efficiencyDist(rng), costDist(rng), staminaDist(rng));
+                handles.push_back(worker.get());
+                benchManager.addWorker(std::move(worker));
+            }
+            return benchManager;
+        };
+        auto restAll = [](const std::vector<SimulatedWorker*>& handles) {
+            for (auto* worker : handles) {
+                if (worker->needsRest()) {
+                    worker->sleep();
+                }
+            }
+        };
+        auto secondsSince = [](auto start) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+        
+        std::vector<SimulatedWorker*> handles;
+        WorkerManager benchManager = makeManager(handles);
+        
+        // Baseline: serial processWork, one quantum per available worker
+        double serialSeconds = 0.0;
+        for (int round = 0; round < rounds; ++round) {
+            auto start = std::chrono::steady_clock::now();
+            benchManager.processWork();
+            serialSeconds += secondsSince(start);
+            restAll(handles);
+        }
+        double serialQuanta = static_cast<double>(workerCount) * rounds;
+        std::cout << "Serial processWork: " << serialQuanta / serialSeconds << " quanta/s" << std::endl;
+        
+        unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        // Always run a multi-threaded pass so stealing is exercised even on
+        // single-core hosts, where it cannot add throughput
+        std::vector<size_t> threadCounts{1, std::max<size_t>(2, hardwareThreads)};
+        for (size_t threads : threadCounts) {
+            benchManager = makeManager(handles);
+            WorkStealingScheduler scheduler(WorkStealingScheduler::Options{threads, 4});
+            double seconds = 0.0;
+            size_t quanta = 0;
+            size_t steals = 0;
+            size_t rested = 0;
+            for (int round = 0; round < rounds; ++round) {
+                auto start = std::chrono::steady_clock::now();
+                auto report = benchManager.processWork(scheduler);
+                seconds += secondsSince(start);
+                quanta += report.quanta;
+                steals += report.steals;
+                rested += report.rested;
+                restAll(handles);
+            }
+            std::cout << "Work-stealing, " << threads << " thread(s): "
+                      << static_cast<double>(quanta) / seconds << " quanta/s ("
+                      << quanta << " quanta, " << steals << " steals, " << rested << " rest stops)" << std::endl;
+        }
+        std::cout << "Hardware threads: " << hardwareThreads << std::endl;
+    }
+    
     return 0;
 } 
\ No newline at end of file
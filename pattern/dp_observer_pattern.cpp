@@ -5,6 +5,33 @@
 #include <algorithm>
 #include <functional>
 #include <map>
+#include <ctime>
+#include <string_view>
+#include <unordered_map>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <stdexcept>
+#include <shared_mutex>
+#include <deque>
+#include <array>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+
+#include "callable.hpp"
+#include "counting_resource.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 // Observer Pattern
 // Define a one-to-many dependency between objects so that when one object changes state,
@@ -27,7 +54,493 @@ public:
     virtual void notify(const std::string& message) = 0;
 };
 
+// Grace periods for readers that never lock. A reader pins the domain by
+// bumping one of two striped counters, picked by the parity of the current
+// epoch. synchronize() flips the parity and waits for the old one's counters
+// to drain, twice (as userspace RCU does): a reader that loaded the epoch
+// before the first flip but pinned after it sits in the parity the second
+// wait drains. After it returns, no reader still holds anything it could
+// have seen before the call.
+class EpochDomain {
+public:
+    class Guard {
+    public:
+        explicit Guard(const EpochDomain& domain) : domain(domain), previous(activeGuards) {
+            const uint64_t epoch = domain.epoch.load(std::memory_order_seq_cst);
+            counter = &domain.stripes[stripeIndex()].readers[epoch & 1];
+            counter->fetch_add(1, std::memory_order_seq_cst);
+            activeGuards = this;
+        }
+        
+        ~Guard() {
+            activeGuards = previous;
+            counter->fetch_sub(1, std::memory_order_release);
+        }
+        
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        
+    private:
+        friend class EpochDomain;
+        const EpochDomain& domain;
+        const Guard* previous;
+        std::atomic<uint32_t>* counter;
+    };
+    
+    // True inside a Guard of this domain on the calling thread, where
+    // synchronize() would wait for itself
+    bool pinnedByCurrentThread() const noexcept {
+        for (const Guard* guard = activeGuards; guard; guard = guard->previous) {
+            if (&guard->domain == this) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void synchronize() {
+        std::lock_guard<std::mutex> lock(syncMutex);
+        const uint64_t start = epoch.load(std::memory_order_relaxed);
+        for (int flip = 0; flip < 2; ++flip) {
+            const uint64_t previous = epoch.fetch_add(1, std::memory_order_seq_cst);
+            for (auto& stripe : stripes) {
+                while (stripe.readers[previous & 1].load(std::memory_order_seq_cst) != 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        completed.store(start + 2, std::memory_order_release);
+    }
+    
+    uint64_t currentEpoch() const noexcept { return epoch.load(std::memory_order_seq_cst); }
+    
+    // Whether a grace period has fully elapsed since currentEpoch() returned
+    // retiredAt, i.e. a whole synchronize() started at or after that epoch
+    // (one that was already between its flips does not count)
+    bool elapsedSince(uint64_t retiredAt) const noexcept {
+        return completed.load(std::memory_order_acquire) >= retiredAt + 2;
+    }
+    
+private:
+    static constexpr size_t kStripes = 16;
+    
+    struct alignas(64) Stripe {
+        mutable std::atomic<uint32_t> readers[2] = {};
+    };
+    
+    static size_t stripeIndex() noexcept {
+        thread_local const size_t index = std::hash<std::thread::id>{}(std::this_thread::get_id()) % kStripes;
+        return index;
+    }
+    
+    inline static thread_local const Guard* activeGuards = nullptr;
+    
+    std::array<Stripe, kStripes> stripes;
+    std::atomic<uint64_t> epoch{0};
+    std::atomic<uint64_t> completed{0};
+    std::mutex syncMutex;
+};
+
+// Generation-checked reference to a slot; stale once the slot is detached
+struct SubscriptionHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+    
+    bool valid() const { return index != UINT32_MAX; }
+};
+
+// Slot map of non-owning observer pointers. attach/detach are O(1) via a
+// free list and may run while notifications iterate: slots live in chunks
+// that never move, and a detached slot is only reused after an epoch grace
+// period. detach() waits for that grace period, so the observer may be
+// destroyed as soon as it returns - except when called from inside a
+// notification of the same list, where it defers reuse instead of waiting
+// (the observer being notified must then outlive the current notification).
+class SubscriptionSlots {
+public:
+    SubscriptionSlots() = default;
+    
+    ~SubscriptionSlots() {
+        for (auto& chunk : chunks) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+    
+    SubscriptionSlots(const SubscriptionSlots&) = delete;
+    SubscriptionSlots& operator=(const SubscriptionSlots&) = delete;
+    
+    SubscriptionHandle attach(void* observer) {
+        // Slots detached from callbacks are only reusable after a grace period
+        if (retiredCount.load(std::memory_order_relaxed) >= kRetiredBatch && !domain.pinnedByCurrentThread()) {
+            domain.synchronize();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        reclaimRetired();
+        uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            index = static_cast<uint32_t>(highWater.load(std::memory_order_relaxed));
+            if (index >= kChunkSize * kMaxChunks) {
+                throw std::length_error("Too many subscriptions");
+            }
+            if (index % kChunkSize == 0) {
+                chunks[index / kChunkSize].store(new Slot[kChunkSize], std::memory_order_release);
+            }
+        }
+        Slot& slot = slotAt(index);
+        slot.observer.store(observer, std::memory_order_release);
+        if (index == highWater.load(std::memory_order_relaxed)) {
+            highWater.store(index + 1, std::memory_order_release);
+        }
+        live.fetch_add(1, std::memory_order_relaxed);
+        return {index, slot.generation.load(std::memory_order_relaxed)};
+    }
+    
+    // Returns false for stale or already-detached handles
+    bool detach(SubscriptionHandle handle) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!holds(handle)) {
+                return false;
+            }
+            Slot& slot = slotAt(handle.index);
+            slot.observer.store(nullptr, std::memory_order_seq_cst);
+            slot.generation.fetch_add(1, std::memory_order_relaxed);
+            live.fetch_sub(1, std::memory_order_relaxed);
+            if (domain.pinnedByCurrentThread()) {
+                retired.push_back({handle.index, domain.currentEpoch()});
+                retiredCount.store(retired.size(), std::memory_order_relaxed);
+                return true;
+            }
+        }
+        // Outside the lock so callbacks that attach/detach cannot deadlock
+        domain.synchronize();
+        std::lock_guard<std::mutex> lock(mutex);
+        freeSlots.push_back(handle.index);
+        return true;
+    }
+    
+    bool contains(SubscriptionHandle handle) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return holds(handle);
+    }
+    
+    // Lock-free, for notify paths; a snapshot while attach/detach race
+    size_t size() const {
+        return live.load(std::memory_order_relaxed);
+    }
+    
+    // Lock-free; visits every observer attached before the call starts and
+    // never one whose detach() has returned
+    template<typename Func>
+    void forEach(Func&& func) const {
+        EpochDomain::Guard guard(domain);
+        const size_t end = highWater.load(std::memory_order_acquire);
+        for (size_t index = 0; index < end; ++index) {
+            if (void* observer = slotAt(index).observer.load(std::memory_order_seq_cst)) {
+                func(observer);
+            }
+        }
+    }
+    
+private:
+    static constexpr size_t kChunkSize = 256;
+    static constexpr size_t kMaxChunks = 1024;
+    static constexpr size_t kRetiredBatch = 32;
+    
+    struct Slot {
+        std::atomic<void*> observer{nullptr};
+        std::atomic<uint32_t> generation{0};
+    };
+    
+    struct Retired {
+        uint32_t index;
+        uint64_t epoch;
+    };
+    
+    Slot& slotAt(size_t index) const {
+        return chunks[index / kChunkSize].load(std::memory_order_acquire)[index % kChunkSize];
+    }
+    
+    bool holds(SubscriptionHandle handle) const {
+        if (!handle.valid() || handle.index >= highWater.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        const Slot& slot = slotAt(handle.index);
+        return slot.generation.load(std::memory_order_relaxed) == handle.generation &&
+               slot.observer.load(std::memory_order_relaxed) != nullptr;
+    }
+    
+    void reclaimRetired() {
+        auto ready = std::partition(retired.begin(), retired.end(),
+            [this](const Retired& entry) { return !domain.elapsedSince(entry.epoch); });
+        for (auto it = ready; it != retired.end(); ++it) {
+            freeSlots.push_back(it->index);
+        }
+        retired.erase(ready, retired.end());
+        retiredCount.store(retired.size(), std::memory_order_relaxed);
+    }
+    
+    std::array<std::atomic<Slot*>, kMaxChunks> chunks{};
+    std::atomic<size_t> highWater{0};
+    EpochDomain domain;
+    std::atomic<size_t> retiredCount{0};
+    
+    mutable std::mutex mutex; // attach/detach only
+    std::vector<uint32_t> freeSlots;
+    std::vector<Retired> retired; // detached from inside a notification
+    std::atomic<size_t> live{0};  // written under mutex, read without it
+};
+
+// RAII subscription: detaches on destruction. Holds the slots weakly, so it
+// may safely outlive the subject it came from.
+class Subscription {
+public:
+    Subscription() = default;
+    
+    Subscription(std::weak_ptr<SubscriptionSlots> slots, SubscriptionHandle handle)
+        : slots(std::move(slots)), handle(handle) {}
+    
+    Subscription(Subscription&& other) noexcept
+        : slots(std::move(other.slots)), handle(std::exchange(other.handle, SubscriptionHandle{})) {}
+    
+    Subscription& operator=(Subscription&& other) noexcept {
+        if (this != &other) {
+            reset();
+            slots = std::move(other.slots);
+            handle = std::exchange(other.handle, SubscriptionHandle{});
+        }
+        return *this;
+    }
+    
+    ~Subscription() {
+        reset();
+    }
+    
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+    
+    void reset() {
+        if (!handle.valid()) {
+            return;
+        }
+        if (auto owner = slots.lock()) {
+            owner->detach(handle);
+        }
+        slots.reset();
+        handle = SubscriptionHandle{};
+    }
+    
+    bool active() const {
+        auto owner = slots.lock();
+        return owner && owner->contains(handle);
+    }
+    
+    SubscriptionHandle getHandle() const { return handle; }
+    
+private:
+    std::weak_ptr<SubscriptionSlots> slots;
+    SubscriptionHandle handle;
+};
+
+// Typed front end over SubscriptionSlots
+template<typename T>
+class ObserverList {
+public:
+    [[nodiscard]] Subscription subscribe(T& observer) {
+        return Subscription(slots, slots->attach(&observer));
+    }
+    
+    bool detach(SubscriptionHandle handle) { return slots->detach(handle); }
+    bool contains(SubscriptionHandle handle) const { return slots->contains(handle); }
+    size_t size() const { return slots->size(); }
+    
+    template<typename Func>
+    void notify(Func&& func) const {
+        slots->forEach([&func](void* observer) { func(*static_cast<T*>(observer)); });
+    }
+    
+private:
+    std::shared_ptr<SubscriptionSlots> slots = std::make_shared<SubscriptionSlots>();
+};
+
+// Typed weather sample for high-rate subscribers; no formatting on the hot path
+struct Measurement {
+    float temperature = 0.0f;
+    float humidity = 0.0f;
+    float pressure = 0.0f;
+    uint64_t sequence = 0;
+    int64_t timestampNs = 0; // steady clock
+};
+
+class MeasurementObserver {
+public:
+    virtual ~MeasurementObserver() = default;
+    virtual void onMeasurement(const Measurement& measurement) = 0;
+    virtual std::string getName() const = 0;
+};
+
+// How a measurement subscriber wants to be fed
+struct DeliveryOptions {
+    enum class Mode {
+        Queue,  // every sample, oldest dropped when the mailbox is full
+        Latest  // only the newest undelivered sample; the rest coalesce
+    };
+    Mode mode = Mode::Queue;
+    double maxRateHz = 0.0;      // 0 = as fast as the observer keeps up
+    size_t mailboxCapacity = 1024; // Queue mode only
+};
+
+// Per-subscriber mailbox drained by its own delivery thread, so a slow
+// observer only ever delays itself. The producer side is a short critical
+// section plus a notify when the consumer is idle.
+class MeasurementMailbox {
+public:
+    struct Stats {
+        uint64_t delivered = 0;
+        uint64_t coalesced = 0; // overwritten before delivery (Latest mode)
+        uint64_t dropped = 0;   // evicted from a full queue (Queue mode)
+        uint64_t failed = 0;    // onMeasurement threw; delivery carries on
+    };
+    
+    MeasurementMailbox(std::shared_ptr<MeasurementObserver> observer, DeliveryOptions options)
+        : observer(std::move(observer)), options(options),
+          queue(options.mode == DeliveryOptions::Mode::Queue ? std::max<size_t>(1, options.mailboxCapacity) : 1) {
+        if (options.maxRateHz > 0.0) {
+            minInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(1.0 / options.maxRateHz));
+        }
+        worker = std::thread([this] { run(); });
+    }
+    
+    // Pending samples are discarded; call drain() first to deliver them
+    ~MeasurementMailbox() {
+        stop();
+        worker.join();
+    }
+    
+    // Ends delivery after the current sample without joining, so the
+    // mailbox's own observer can retire it from inside onMeasurement()
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeConsumer.notify_one();
+        drained.notify_all();
+    }
+    
+    // True on any mailbox's delivery thread, where joining a mailbox could
+    // wait on itself or on a thread that is waiting on this one
+    [[nodiscard]] static bool onDeliveryThread() noexcept {
+        return isDeliveryThread;
+    }
+    
+    MeasurementMailbox(const MeasurementMailbox&) = delete;
+    MeasurementMailbox& operator=(const MeasurementMailbox&) = delete;
+    
+    void post(const Measurement& measurement) {
+        bool wake;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (count == queue.size()) {
+                head = (head + 1) % queue.size();
+                --count;
+                ++(options.mode == DeliveryOptions::Mode::Latest ? stats.coalesced : stats.dropped);
+            }
+            queue[(head + count) % queue.size()] = measurement;
+            ++count;
+            wake = consumerIdle;
+        }
+        if (wake) {
+            wakeConsumer.notify_one();
+        }
+    }
+    
+    // Blocks until everything posted so far has been delivered or discarded
+    void drain() {
+        std::unique_lock<std::mutex> lock(mutex);
+        drained.wait(lock, [this] { return (count == 0 || stopping) && !delivering; });
+    }
+    
+    [[nodiscard]] Stats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+    
+    const std::shared_ptr<MeasurementObserver>& getObserver() const { return observer; }
+    
+private:
+    void run() {
+        isDeliveryThread = true;
+        std::unique_lock<std::mutex> lock(mutex);
+        auto nextDue = std::chrono::steady_clock::time_point::min();
+        for (;;) {
+            consumerIdle = true;
+            wakeConsumer.wait(lock, [this] { return stopping || count > 0; });
+            consumerIdle = false;
+            if (stopping) {
+                return;
+            }
+            // Rate limit: samples keep arriving (and coalescing) meanwhile
+            if (std::chrono::steady_clock::now() < nextDue &&
+                wakeConsumer.wait_until(lock, nextDue, [this] { return stopping; })) {
+                return;
+            }
+            Measurement measurement = queue[head];
+            head = (head + 1) % queue.size();
+            --count;
+            delivering = true;
+            lock.unlock();
+            bool threw = false;
+            try {
+                observer->onMeasurement(measurement);
+            } catch (...) {
+                threw = true; // one bad sample must not kill the delivery thread
+            }
+            const auto now = std::chrono::steady_clock::now();
+            lock.lock();
+            delivering = false;
+            ++(threw ? stats.failed : stats.delivered);
+            if (minInterval.count() > 0) {
+                nextDue = now + minInterval;
+            }
+            if (count == 0 || stopping) {
+                drained.notify_all();
+            }
+        }
+    }
+    
+    std::shared_ptr<MeasurementObserver> observer;
+    DeliveryOptions options;
+    std::chrono::steady_clock::duration minInterval{0};
+    
+    mutable std::mutex mutex;
+    std::condition_variable wakeConsumer;
+    std::condition_variable drained;
+    std::vector<Measurement> queue; // ring; a single slot in Latest mode
+    size_t head = 0;
+    size_t count = 0;
+    bool consumerIdle = false;
+    bool delivering = false;
+    bool stopping = false;
+    Stats stats;
+    std::thread worker;
+    
+    inline static thread_local bool isDeliveryThread = false;
+};
+
 // Concrete Subject: Weather Station
+// String observers are notified synchronously; measurement subscribers get a
+// typed sample through their own mailbox. setMeasurements() is meant to be
+// called from a single producer thread. Observers registered with
+// subscribe() are not owned and may attach/detach from any thread while a
+// notification runs. Measurement observers may unsubscribe from any thread,
+// including from inside onMeasurement(): a delivery thread cannot safely
+// join a mailbox, so there the mailbox is stopped and joined later by the
+// next call from another thread, or by the station's destructor.
 class WeatherStation : public Subject {
 public:
     void attach(std::shared_ptr<Observer> observer) override {
@@ -35,178 +548,1380 @@ public:
         std::cout << "Observer " << observer->getName() << " attached" << std::endl;
     }
     
-    void detach(std::shared_ptr<Observer> observer) override {
-        auto it = std::find(observers.begin(), observers.end(), observer);
-        if (it != observers.end()) {
-            observers.erase(it);
-            std::cout << "Observer " << observer->getName() << " detached" << std::endl;
+    void detach(std::shared_ptr<Observer> observer) override {
+        auto it = std::find(observers.begin(), observers.end(), observer);
+        if (it != observers.end()) {
+            observers.erase(it);
+            std::cout << "Observer " << observer->getName() << " detached" << std::endl;
+        }
+    }
+    
+    // Non-owning; the observer is detached when the token is destroyed
+    [[nodiscard]] Subscription subscribe(Observer& observer) {
+        std::cout << "Observer " << observer.getName() << " subscribed" << std::endl;
+        return subscriptions.subscribe(observer);
+    }
+    
+    void notify(const std::string& message) override {
+        std::cout << "Weather Station: Notifying " << observers.size() + subscriptions.size() << " observers" << std::endl;
+        for (auto& observer : observers) {
+            observer->update(message);
+        }
+        subscriptions.notify([&message](Observer& observer) { observer.update(message); });
+    }
+    
+    void subscribeMeasurements(std::shared_ptr<MeasurementObserver> observer, DeliveryOptions options = {}) {
+        std::cout << "Measurement observer " << observer->getName() << " subscribed" << std::endl;
+        auto mailbox = std::make_shared<MeasurementMailbox>(std::move(observer), options);
+        reapRetiredMailboxes();
+        std::lock_guard<std::mutex> lock(mailboxMutex);
+        mailboxes.push_back(std::move(mailbox));
+    }
+    
+    void unsubscribeMeasurements(const std::shared_ptr<MeasurementObserver>& observer) {
+        std::shared_ptr<MeasurementMailbox> removed;
+        {
+            std::lock_guard<std::mutex> lock(mailboxMutex);
+            auto it = std::find_if(mailboxes.begin(), mailboxes.end(),
+                [&](const auto& mailbox) { return mailbox->getObserver() == observer; });
+            if (it == mailboxes.end()) {
+                return;
+            }
+            removed = std::move(*it);
+            mailboxes.erase(it);
+            if (MeasurementMailbox::onDeliveryThread()) {
+                removed->stop();
+                retiredMailboxes.push_back(std::move(removed));
+            }
+        }
+        std::cout << "Measurement observer " << observer->getName() << " unsubscribed" << std::endl;
+        removed.reset(); // joins the delivery thread outside mailboxMutex
+        reapRetiredMailboxes();
+    }
+    
+    void setMeasurements(float temperature, float humidity, float pressure) {
+        this->temperature = temperature;
+        this->humidity = humidity;
+        this->pressure = pressure;
+        
+        {
+            // post() never calls out, so holding the lock cannot deadlock
+            std::lock_guard<std::mutex> lock(mailboxMutex);
+            if (!mailboxes.empty()) {
+                const Measurement measurement{temperature, humidity, pressure, ++sequence,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count()};
+                for (auto& mailbox : mailboxes) {
+                    mailbox->post(measurement);
+                }
+            }
+        }
+        
+        // Only pay for formatting when someone wants the string
+        if (!observers.empty() || subscriptions.size() > 0) {
+            std::string message = "Temperature: " + std::to_string(temperature) + 
+                                 "°C, Humidity: " + std::to_string(humidity) + 
+                                 "%, Pressure: " + std::to_string(pressure) + " hPa";
+            notify(message);
+        }
+    }
+    
+    // Waits until every mailbox has delivered what it holds. Waits outside
+    // mailboxMutex, so observers may unsubscribe while being drained.
+    void drainMeasurements() {
+        std::vector<std::shared_ptr<MeasurementMailbox>> pending;
+        {
+            std::lock_guard<std::mutex> lock(mailboxMutex);
+            pending = mailboxes;
+        }
+        for (auto& mailbox : pending) {
+            mailbox->drain();
+        }
+    }
+    
+    [[nodiscard]] MeasurementMailbox::Stats measurementStats(const std::shared_ptr<MeasurementObserver>& observer) const {
+        std::lock_guard<std::mutex> lock(mailboxMutex);
+        for (const auto& mailbox : mailboxes) {
+            if (mailbox->getObserver() == observer) {
+                return mailbox->getStats();
+            }
+        }
+        return {};
+    }
+    
+    float getTemperature() const { return temperature; }
+    float getHumidity() const { return humidity; }
+    float getPressure() const { return pressure; }
+    
+private:
+    // Joins mailboxes retired from delivery threads, outside mailboxMutex
+    void reapRetiredMailboxes() {
+        if (MeasurementMailbox::onDeliveryThread()) {
+            return;
+        }
+        std::vector<std::shared_ptr<MeasurementMailbox>> reaped;
+        std::lock_guard<std::mutex> lock(mailboxMutex);
+        reaped.swap(retiredMailboxes);
+    }
+    
+    std::vector<std::shared_ptr<Observer>> observers;
+    ObserverList<Observer> subscriptions;
+    mutable std::mutex mailboxMutex;
+    std::vector<std::shared_ptr<MeasurementMailbox>> mailboxes;
+    std::vector<std::shared_ptr<MeasurementMailbox>> retiredMailboxes; // stopped, not yet joined
+    uint64_t sequence = 0;
+    float temperature = 0.0f;
+    float humidity = 0.0f;
+    float pressure = 0.0f;
+};
+
+// Incremental statistics over typed measurements. Every structure below is
+// updated in O(1) (amortised) per sample and uses memory independent of how
+// many samples have been seen, so the history never has to be kept.
+
+// Welford's running mean/variance plus extrema
+class RunningMoments {
+public:
+    void add(double value) noexcept {
+        ++n;
+        const double delta = value - runningMean;
+        runningMean += delta / static_cast<double>(n);
+        m2 += delta * (value - runningMean);
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+    }
+    
+    uint64_t count() const { return n; }
+    double mean() const { return runningMean; }
+    double variance() const { return n > 1 ? m2 / static_cast<double>(n - 1) : 0.0; }
+    double stddev() const { return std::sqrt(variance()); }
+    double min() const { return n ? minimum : 0.0; }
+    double max() const { return n ? maximum : 0.0; }
+    
+private:
+    uint64_t n = 0;
+    double runningMean = 0.0;
+    double m2 = 0.0;
+    double minimum = std::numeric_limits<double>::infinity();
+    double maximum = -std::numeric_limits<double>::infinity();
+};
+
+// Min/max/mean over the trailing time window. Samples are folded into
+// fixed-width buckets; closed buckets feed monotonic deques (for min and
+// max) and a running sum, so memory is bounded by the bucket count and the
+// answer is exact up to one bucket of window-edge resolution. add() only
+// moves the window to its sample's time; when samples may have stopped,
+// call advanceTo(now) before querying so stale buckets are dropped.
+class SlidingWindowAggregate {
+public:
+    explicit SlidingWindowAggregate(std::chrono::nanoseconds window, size_t buckets = 64)
+        : bucketCount(static_cast<int64_t>(std::max<size_t>(1, buckets))),
+          bucketWidthNs(std::max<int64_t>(1, window.count() / bucketCount)) {}
+    
+    void add(int64_t timestampNs, double value) {
+        // Samples older than the window's edge count as arriving at the edge
+        const int64_t index = std::max(timestampNs / bucketWidthNs, newestIndex);
+        newestIndex = index;
+        if (current.count == 0) {
+            current.index = index;
+        } else if (index > current.index) {
+            closeCurrent();
+            current.index = index;
+        }
+        // Late samples fold into the open bucket
+        current.min = current.count ? std::min(current.min, value) : value;
+        current.max = current.count ? std::max(current.max, value) : value;
+        current.sum += value;
+        ++current.count;
+        expire(current.index);
+    }
+    
+    // Slides the window forward with no new sample
+    void advanceTo(int64_t nowNs) {
+        const int64_t index = nowNs / bucketWidthNs;
+        if (index <= newestIndex) {
+            return;
+        }
+        newestIndex = index;
+        if (current.count > 0) {
+            closeCurrent();
+        }
+        expire(index);
+    }
+    
+    double min() const {
+        double result = current.count ? current.min : std::numeric_limits<double>::infinity();
+        return minQueue.empty() ? result : std::min(result, minQueue.front().value);
+    }
+    
+    double max() const {
+        double result = current.count ? current.max : -std::numeric_limits<double>::infinity();
+        return maxQueue.empty() ? result : std::max(result, maxQueue.front().value);
+    }
+    
+    uint64_t count() const { return closedCount + current.count; }
+    
+    double mean() const {
+        const uint64_t total = count();
+        return total ? (closedSum + current.sum) / static_cast<double>(total) : 0.0;
+    }
+    
+    size_t retainedBuckets() const { return totals.size() + minQueue.size() + maxQueue.size(); }
+    
+private:
+    struct Bucket {
+        int64_t index = 0;
+        double min = 0.0;
+        double max = 0.0;
+        double sum = 0.0;
+        uint64_t count = 0;
+    };
+    
+    struct Extreme {
+        int64_t index;
+        double value;
+    };
+    
+    void closeCurrent() {
+        while (!minQueue.empty() && minQueue.back().value >= current.min) {
+            minQueue.pop_back();
+        }
+        minQueue.push_back({current.index, current.min});
+        while (!maxQueue.empty() && maxQueue.back().value <= current.max) {
+            maxQueue.pop_back();
+        }
+        maxQueue.push_back({current.index, current.max});
+        totals.push_back(current);
+        closedSum += current.sum;
+        closedCount += current.count;
+        current = Bucket{};
+    }
+    
+    void expire(int64_t newest) {
+        const int64_t oldestKept = newest - bucketCount + 1;
+        while (!totals.empty() && totals.front().index < oldestKept) {
+            closedSum -= totals.front().sum;
+            closedCount -= totals.front().count;
+            totals.pop_front();
+        }
+        while (!minQueue.empty() && minQueue.front().index < oldestKept) {
+            minQueue.pop_front();
+        }
+        while (!maxQueue.empty() && maxQueue.front().index < oldestKept) {
+            maxQueue.pop_front();
+        }
+    }
+    
+    int64_t bucketCount;
+    int64_t bucketWidthNs;
+    Bucket current;
+    std::deque<Bucket> totals;     // closed buckets still inside the window
+    std::deque<Extreme> minQueue;  // increasing values
+    std::deque<Extreme> maxQueue;  // decreasing values
+    double closedSum = 0.0;
+    uint64_t closedCount = 0;
+    int64_t newestIndex = std::numeric_limits<int64_t>::min(); // latest bucket seen
+};
+
+// Merging t-digest (Dunning): approximate quantiles in O(compression)
+// memory, most accurate near the tails. Samples are buffered and merged in
+// sorted batches, so add() is amortised O(log buffer).
+class TDigest {
+public:
+    explicit TDigest(double compression = 100.0)
+        : compression(compression), bufferLimit(static_cast<size_t>(compression) * 5) {
+        centroids.reserve(static_cast<size_t>(compression) * 2);
+        buffer.reserve(bufferLimit);
+    }
+    
+    void add(double value) {
+        buffer.push_back({value, 1.0});
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+        if (buffer.size() >= bufferLimit) {
+            merge();
+        }
+    }
+    
+    double quantile(double q) {
+        merge();
+        if (centroids.empty()) {
+            return 0.0;
+        }
+        if (centroids.size() == 1) {
+            return centroids.front().mean;
+        }
+        const double target = std::clamp(q, 0.0, 1.0) * totalWeight;
+        // Interpolate between centroid centres, using min/max at the ends
+        double cumulative = 0.0;
+        double previousCentre = 0.0;
+        double previousMean = minimum;
+        for (const Centroid& centroid : centroids) {
+            const double centre = cumulative + centroid.weight / 2.0;
+            if (target < centre) {
+                const double span = centre - previousCentre;
+                const double t = span > 0.0 ? (target - previousCentre) / span : 0.0;
+                return previousMean + t * (centroid.mean - previousMean);
+            }
+            cumulative += centroid.weight;
+            previousCentre = centre;
+            previousMean = centroid.mean;
+        }
+        const double span = totalWeight - previousCentre;
+        const double t = span > 0.0 ? (target - previousCentre) / span : 1.0;
+        return previousMean + t * (maximum - previousMean);
+    }
+    
+    uint64_t count() const { return static_cast<uint64_t>(totalWeight) + buffer.size(); }
+    size_t centroidCount() const { return centroids.size(); }
+    
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+    
+    static constexpr double kPi = 3.14159265358979323846;
+    
+    // k1 scale function: small centroids at the tails, large in the middle
+    double scale(double q) const {
+        return compression / (2.0 * kPi) * std::asin(2.0 * q - 1.0);
+    }
+    
+    double inverseScale(double k) const {
+        if (k >= compression / 4.0) {
+            return 1.0;
+        }
+        return (std::sin(k * 2.0 * kPi / compression) + 1.0) / 2.0;
+    }
+    
+    void merge() {
+        if (buffer.empty()) {
+            return;
+        }
+        auto byMean = [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; };
+        std::sort(buffer.begin(), buffer.end(), byMean);
+        scratch.resize(centroids.size() + buffer.size());
+        std::merge(centroids.begin(), centroids.end(), buffer.begin(), buffer.end(), scratch.begin(), byMean);
+        totalWeight += static_cast<double>(buffer.size());
+        buffer.clear();
+        centroids.clear();
+        
+        // Greedily grow each centroid until it would span more than one unit of k
+        double mergedWeight = 0.0;
+        double limit = totalWeight * inverseScale(scale(0.0) + 1.0);
+        Centroid open = scratch.front();
+        for (size_t i = 1; i < scratch.size(); ++i) {
+            const Centroid& next = scratch[i];
+            if (mergedWeight + open.weight + next.weight <= limit) {
+                open.weight += next.weight;
+                open.mean += (next.mean - open.mean) * next.weight / open.weight;
+            } else {
+                mergedWeight += open.weight;
+                centroids.push_back(open);
+                limit = totalWeight * inverseScale(scale(mergedWeight / totalWeight) + 1.0);
+                open = next;
+            }
+        }
+        centroids.push_back(open);
+    }
+    
+    double compression;
+    size_t bufferLimit;
+    std::vector<Centroid> centroids;
+    std::vector<Centroid> buffer;
+    std::vector<Centroid> scratch;
+    double totalWeight = 0.0;
+    double minimum = std::numeric_limits<double>::infinity();
+    double maximum = -std::numeric_limits<double>::infinity();
+};
+
+// All three aggregates for one measurement channel
+class ChannelStatistics {
+public:
+    explicit ChannelStatistics(std::chrono::nanoseconds windowLength = std::chrono::seconds(60))
+        : window(windowLength) {}
+    
+    void add(int64_t timestampNs, double value) {
+        moments.add(value);
+        window.add(timestampNs, value);
+        digest.add(value);
+    }
+    
+    void advanceTo(int64_t nowNs) {
+        window.advanceTo(nowNs);
+    }
+    
+    const RunningMoments& getMoments() const { return moments; }
+    const SlidingWindowAggregate& getWindow() const { return window; }
+    TDigest& getDigest() { return digest; }
+    
+private:
+    RunningMoments moments;
+    SlidingWindowAggregate window;
+    TDigest digest;
+};
+
+// Concrete Observers
+class CurrentConditionsDisplay : public Observer, public MeasurementObserver {
+public:
+    CurrentConditionsDisplay(const std::string& name) : name(name) {}
+    
+    void update(const std::string& message) override {
+        std::cout << "[" << name << "] Current conditions: " << message << std::endl;
+    }
+    
+    void onMeasurement(const Measurement& measurement) override {
+        std::cout << "[" << name << "] Current conditions #" << measurement.sequence << ": "
+                  << measurement.temperature << "°C, " << measurement.humidity << "%, "
+                  << measurement.pressure << " hPa" << std::endl;
+    }
+    
+    std::string getName() const override {
+        return name;
+    }
+    
+private:
+    std::string name;
+};
+
+// String updates are only echoed; typed measurements feed the incremental
+// statistics, which may be read while a mailbox thread keeps updating them
+class StatisticsDisplay : public Observer, public MeasurementObserver {
+public:
+    StatisticsDisplay(const std::string& name, std::chrono::nanoseconds window = std::chrono::seconds(60))
+        : name(name), temperature(window), humidity(window), pressure(window) {}
+    
+    void update(const std::string& message) override {
+        std::cout << "[" << name << "] Statistics updated: " << message << std::endl;
+    }
+    
+    void onMeasurement(const Measurement& measurement) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        temperature.add(measurement.timestampNs, measurement.temperature);
+        humidity.add(measurement.timestampNs, measurement.humidity);
+        pressure.add(measurement.timestampNs, measurement.pressure);
+    }
+    
+    void printStatistics() {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Same clock as Measurement::timestampNs; a quiet sensor's samples
+        // still age out of the window
+        const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        auto print = [this, nowNs](const char* label, ChannelStatistics& channel) {
+            channel.advanceTo(nowNs);
+            const RunningMoments& all = channel.getMoments();
+            const SlidingWindowAggregate& recent = channel.getWindow();
+            TDigest& digest = channel.getDigest();
+            std::cout << "[" << name << "] " << label << ": n=" << all.count() << " mean=" << all.mean()
+                      << " sd=" << all.stddev() << " min=" << all.min() << " max=" << all.max()
+                      << " | window mean=" << recent.mean() << " min=" << recent.min() << " max=" << recent.max()
+                      << " | p50=" << digest.quantile(0.5) << " p99=" << digest.quantile(0.99) << std::endl;
+        };
+        print("Temperature", temperature);
+        print("Humidity", humidity);
+        print("Pressure", pressure);
+    }
+    
+    std::string getName() const override {
+        return name;
+    }
+    
+private:
+    std::string name;
+    std::mutex mutex;
+    ChannelStatistics temperature;
+    ChannelStatistics humidity;
+    ChannelStatistics pressure;
+};
+
+class ForecastDisplay : public Observer {
+public:
+    ForecastDisplay(const std::string& name) : name(name) {}
+    
+    void update(const std::string& message) override {
+        std::cout << "[" << name << "] Forecast updated: " << message << std::endl;
+        // In a real implementation, this would generate weather forecasts
+    }
+    
+    std::string getName() const override {
+        return name;
+    }
+    
+private:
+    std::string name;
+};
+
+// Modern Observer using inline callables (no allocation per callback)
+class ModernSubject {
+public:
+    // Accepts lambdas and std::function alike
+    using ObserverCallback = InplaceFunction<void(const std::string&)>;
+    
+    void attach(const std::string& name, ObserverCallback callback) {
+        observers[name] = std::move(callback);
+        std::cout << "Observer " << name << " attached (modern)" << std::endl;
+    }
+    
+    void detach(const std::string& name) {
+        if (observers.erase(name) > 0) {
+            std::cout << "Observer " << name << " detached (modern)" << std::endl;
+        }
+    }
+    
+    void notify(const std::string& message) {
+        std::cout << "Modern Subject: Notifying " << observers.size() << " observers" << std::endl;
+        for (auto& [name, callback] : observers) {
+            callback(message);
+        }
+    }
+    
+    void setData(const std::string& data) {
+        this->data = data;
+        notify("Data changed to: " + data);
+    }
+    
+private:
+    std::map<std::string, ObserverCallback> observers;
+    std::string data;
+};
+
+// Event-driven Observer Pattern
+using EventTypeId = uint32_t;
+
+// Grow-only array indexed by dense ids. Segment k holds kFirstSegment << k
+// slots, so slots never move and any id below 2^32 fits in kSegments
+// segments. Readers index it without a lock; ensure() creates segments and
+// must be serialized by the caller. Slots start value-initialized.
+template<typename T>
+class SegmentedArray {
+public:
+    static constexpr size_t kFirstSegment = 64;
+    static constexpr size_t kSegments = 27;
+    
+    SegmentedArray() = default;
+    
+    ~SegmentedArray() {
+        for (auto& segment : segments_) {
+            delete[] segment.load(std::memory_order_relaxed);
+        }
+    }
+    
+    SegmentedArray(const SegmentedArray&) = delete;
+    SegmentedArray& operator=(const SegmentedArray&) = delete;
+    
+    // nullptr until ensure() has created the slot's segment
+    [[nodiscard]] T* find(size_t index) const noexcept {
+        const auto [segment, offset] = locate(index);
+        T* base = segments_[segment].load(std::memory_order_acquire);
+        return base ? base + offset : nullptr;
+    }
+    
+    T& ensure(size_t index) {
+        const auto [segment, offset] = locate(index);
+        T* base = segments_[segment].load(std::memory_order_relaxed);
+        if (!base) {
+            base = new T[kFirstSegment << segment]();
+            segments_[segment].store(base, std::memory_order_release);
+        }
+        return base[offset];
+    }
+
+private:
+    // Segment k starts at kFirstSegment * (2^k - 1)
+    static std::pair<size_t, size_t> locate(size_t index) noexcept {
+        size_t segment = 0;
+        for (size_t scaled = index / kFirstSegment + 1; scaled > 1; scaled >>= 1) {
+            ++segment;
+        }
+        return {segment, index - kFirstSegment * ((size_t(1) << segment) - 1)};
+    }
+    
+    std::array<std::atomic<T*>, kSegments> segments_{};
+};
+
+// Process-wide event type names <-> dense integer ids. Ids are never reused,
+// so an id and the name it maps to stay valid for the life of the program.
+// Id 0 is the empty type used by default-constructed events.
+class EventTypeRegistry {
+public:
+    static EventTypeRegistry& instance() {
+        static EventTypeRegistry registry;
+        return registry;
+    }
+    
+    // Lookups of known names take a shared lock and never allocate
+    EventTypeId intern(std::string_view name) {
+        if (auto id = find(name)) {
+            return *id;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+        const size_t id = count_.load(std::memory_order_relaxed);
+        if (id > std::numeric_limits<EventTypeId>::max()) {
+            throw std::length_error("Too many event types");
+        }
+        std::string_view& slot = names_.ensure(id);
+        const std::string& stored = storage_.emplace_back(name);
+        ids_.emplace(stored, static_cast<EventTypeId>(id));
+        slot = stored;
+        count_.store(id + 1, std::memory_order_release);
+        return static_cast<EventTypeId>(id);
+    }
+    
+    // Looks a name up without registering it
+    [[nodiscard]] std::optional<EventTypeId> find(std::string_view name) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it == ids_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+    
+    // Lock-free; unknown ids map to the empty name
+    [[nodiscard]] std::string_view name(EventTypeId id) const noexcept {
+        return id < count_.load(std::memory_order_acquire) ? *names_.find(id) : std::string_view();
+    }
+
+private:
+    EventTypeRegistry() {
+        intern("");
+    }
+    
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, EventTypeId> ids_; // keys view into storage_
+    std::deque<std::string> storage_;                       // stable addresses
+    SegmentedArray<std::string_view> names_;
+    std::atomic<size_t> count_{0};
+};
+
+// Size-classed blocks for event payloads too large to store inline. Blocks
+// are carved from 64 KiB slabs and recycled through a small per-thread cache
+// backed by a shared free list, so once warm, publishing large payloads does
+// not reach operator new. Blocks may be released on a different thread from
+// the one that allocated them (publisher vs dispatcher).
+class EventPayloadPool {
+public:
+    static constexpr size_t kMinBlock = 64;
+    static constexpr size_t kClasses = 8; // 64 B .. 8 KiB
+    static constexpr size_t kMaxPooled = kMinBlock << (kClasses - 1);
+    
+    static char* allocate(size_t bytes) {
+        if (bytes > kMaxPooled) {
+            char* memory = new char[bytes];
+            upstream().fetch_add(1, std::memory_order_relaxed);
+            return memory;
+        }
+        const size_t sizeClass = classOf(bytes);
+        Cache& cache = localCache();
+        if (!cache.heads[sizeClass]) {
+            refill(cache, sizeClass);
+        }
+        FreeBlock* block = cache.heads[sizeClass];
+        cache.heads[sizeClass] = block->next;
+        --cache.counts[sizeClass];
+        return reinterpret_cast<char*>(block);
+    }
+    
+    static void release(char* memory, size_t bytes) noexcept {
+        if (bytes > kMaxPooled) {
+            delete[] memory;
+            return;
+        }
+        const size_t sizeClass = classOf(bytes);
+        Cache& cache = localCache();
+        auto* block = reinterpret_cast<FreeBlock*>(memory);
+        block->next = cache.heads[sizeClass];
+        cache.heads[sizeClass] = block;
+        if (++cache.counts[sizeClass] > kCacheLimit) {
+            spill(cache, sizeClass, kCacheLimit / 2);
+        }
+    }
+    
+    // Slabs, slab-list growth and oversized blocks taken from operator new
+    // so far: everything the pool allocates
+    static size_t upstreamAllocations() noexcept {
+        return upstream().load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t kSlabBytes = 64 * 1024;
+    static constexpr size_t kCacheLimit = 64;
+    
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    
+    struct Shared {
+        std::mutex mutex;
+        FreeBlock* heads[kClasses] = {};
+        std::vector<std::unique_ptr<char[]>> slabs;
+    };
+    
+    struct Cache {
+        FreeBlock* heads[kClasses] = {};
+        size_t counts[kClasses] = {};
+        
+        ~Cache() {
+            for (size_t sizeClass = 0; sizeClass < kClasses; ++sizeClass) {
+                spill(*this, sizeClass, counts[sizeClass]);
+            }
+        }
+    };
+    
+    static size_t classOf(size_t bytes) noexcept {
+        size_t sizeClass = 0;
+        while ((kMinBlock << sizeClass) < bytes) {
+            ++sizeClass;
+        }
+        return sizeClass;
+    }
+    
+    // Intentionally leaked so thread-exit cache flushes never outlive it
+    static Shared& shared() {
+        static Shared* instance = new Shared();
+        return *instance;
+    }
+    
+    static Cache& localCache() {
+        thread_local Cache cache;
+        return cache;
+    }
+    
+    static std::atomic<size_t>& upstream() noexcept {
+        static std::atomic<size_t> allocations{0};
+        return allocations;
+    }
+    
+    static void refill(Cache& cache, size_t sizeClass) {
+        Shared& pool = shared();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (!pool.heads[sizeClass]) {
+            const size_t blockSize = kMinBlock << sizeClass;
+            if (pool.slabs.size() == pool.slabs.capacity()) {
+                upstream().fetch_add(1, std::memory_order_relaxed); // the slab list grows
+            }
+            char* slab = pool.slabs.emplace_back(std::make_unique<char[]>(kSlabBytes)).get();
+            upstream().fetch_add(1, std::memory_order_relaxed);
+            for (size_t offset = 0; offset + blockSize <= kSlabBytes; offset += blockSize) {
+                auto* block = reinterpret_cast<FreeBlock*>(slab + offset);
+                block->next = pool.heads[sizeClass];
+                pool.heads[sizeClass] = block;
+            }
+        }
+        for (size_t taken = 0; taken < kCacheLimit / 2 && pool.heads[sizeClass]; ++taken) {
+            FreeBlock* block = pool.heads[sizeClass];
+            pool.heads[sizeClass] = block->next;
+            block->next = cache.heads[sizeClass];
+            cache.heads[sizeClass] = block;
+            ++cache.counts[sizeClass];
+        }
+    }
+    
+    static void spill(Cache& cache, size_t sizeClass, size_t count) noexcept {
+        Shared& pool = shared();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        for (; count > 0 && cache.heads[sizeClass]; --count) {
+            FreeBlock* block = cache.heads[sizeClass];
+            cache.heads[sizeClass] = block->next;
+            block->next = pool.heads[sizeClass];
+            pool.heads[sizeClass] = block;
+            --cache.counts[sizeClass];
+        }
+    }
+};
+
+// One cache line: interned type id, payload length, monotonic timestamp and
+// either the payload itself (up to kInlineBytes) or a pooled block. Building,
+// moving and reading an event with a small payload never allocates.
+class Event {
+public:
+    static constexpr size_t kInlineBytes = 48;
+    
+    Event() noexcept : timestampNs(0) {}
+    
+    Event(EventTypeId type, std::string_view data)
+        : type(type), size(static_cast<uint32_t>(data.size())), timestampNs(nowNs()) {
+        char* target = inlineStorage;
+        if (size > kInlineBytes) {
+            pooled = EventPayloadPool::allocate(size);
+            target = pooled;
+        }
+        std::memcpy(target, data.data(), size);
+    }
+    
+    Event(std::string_view type, std::string_view data)
+        : Event(EventTypeRegistry::instance().intern(type), data) {}
+    
+    Event(const Event& other)
+        : type(other.type), size(other.size), timestampNs(other.timestampNs) {
+        char* target = inlineStorage;
+        if (size > kInlineBytes) {
+            pooled = EventPayloadPool::allocate(size);
+            target = pooled;
         }
+        std::memcpy(target, other.getData().data(), size);
     }
     
-    void notify(const std::string& message) override {
-        std::cout << "Weather Station: Notifying " << observers.size() << " observers" << std::endl;
-        for (auto& observer : observers) {
-            observer->update(message);
+    Event(Event&& other) noexcept
+        : type(other.type), size(other.size), timestampNs(other.timestampNs) {
+        std::memcpy(inlineStorage, other.inlineStorage, sizeof(inlineStorage));
+        other.size = 0;
+    }
+    
+    Event& operator=(const Event& other) {
+        if (this != &other) {
+            Event copy(other);
+            *this = std::move(copy);
         }
+        return *this;
     }
     
-    void setMeasurements(float temperature, float humidity, float pressure) {
-        this->temperature = temperature;
-        this->humidity = humidity;
-        this->pressure = pressure;
-        
-        std::string message = "Temperature: " + std::to_string(temperature) + 
-                             "°C, Humidity: " + std::to_string(humidity) + 
-                             "%, Pressure: " + std::to_string(pressure) + " hPa";
-        notify(message);
+    Event& operator=(Event&& other) noexcept {
+        if (this != &other) {
+            releasePayload();
+            type = other.type;
+            size = other.size;
+            timestampNs = other.timestampNs;
+            std::memcpy(inlineStorage, other.inlineStorage, sizeof(inlineStorage));
+            other.size = 0;
+        }
+        return *this;
     }
     
-    float getTemperature() const { return temperature; }
-    float getHumidity() const { return humidity; }
-    float getPressure() const { return pressure; }
+    ~Event() {
+        releasePayload();
+    }
+    
+    EventTypeId getTypeId() const { return type; }
+    std::string_view getType() const { return EventTypeRegistry::instance().name(type); }
+    std::string_view getData() const { return {size > kInlineBytes ? pooled : inlineStorage, size}; }
+    // Nanoseconds on the steady clock; for ordering and latency, not wall time
+    int64_t getTimestampNs() const { return timestampNs; }
     
 private:
-    std::vector<std::shared_ptr<Observer>> observers;
-    float temperature = 0.0f;
-    float humidity = 0.0f;
-    float pressure = 0.0f;
+    static int64_t nowNs() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+    void releasePayload() noexcept {
+        if (size > kInlineBytes) {
+            EventPayloadPool::release(pooled, size);
+        }
+    }
+    
+    EventTypeId type = 0;
+    uint32_t size = 0;
+    int64_t timestampNs;
+    union {
+        char inlineStorage[kInlineBytes];
+        char* pooled;
+    };
 };
 
-// Concrete Observers
-class CurrentConditionsDisplay : public Observer {
+class EventObserver {
 public:
-    CurrentConditionsDisplay(const std::string& name) : name(name) {}
-    
-    void update(const std::string& message) override {
-        std::cout << "[" << name << "] Current conditions: " << message << std::endl;
-    }
+    virtual ~EventObserver() = default;
+    virtual void onEvent(const Event& event) = 0;
+    virtual std::string getName() const = 0;
     
-    std::string getName() const override {
-        return name;
+    // Batched delivery from EventBus; override to amortise per-event work
+    virtual void onEvents(const Event* events, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            onEvent(events[i]);
+        }
     }
-    
-private:
-    std::string name;
 };
 
-class StatisticsDisplay : public Observer {
+// Subscribers are indexed by interned type id, so publish() is a vector
+// index rather than a string-keyed map lookup. Handle-based subscriptions
+// are non-owning and may come and go while another thread publishes.
+class EventSubject {
 public:
-    StatisticsDisplay(const std::string& name) : name(name) {}
+    EventSubject() = default;
     
-    void update(const std::string& message) override {
-        std::cout << "[" << name << "] Statistics updated: " << message << std::endl;
-        // In a real implementation, this would calculate and store statistics
+    EventSubject(const EventSubject&) = delete;
+    EventSubject& operator=(const EventSubject&) = delete;
+    
+    // Non-owning; the observer is detached when the token is destroyed
+    [[nodiscard]] Subscription subscribe(std::string_view eventType, EventObserver& observer) {
+        const EventTypeId type = EventTypeRegistry::instance().intern(eventType);
+        ObserverList<EventObserver>* list = handleListFor(type);
+        if (!list) {
+            std::lock_guard<std::mutex> lock(listsMutex);
+            auto& slot = handleLists.ensure(type);
+            list = slot.load(std::memory_order_relaxed);
+            if (!list) {
+                list = ownedHandleLists.emplace_back(std::make_unique<ObserverList<EventObserver>>()).get();
+                slot.store(list, std::memory_order_release);
+            }
+        }
+        std::cout << "Observer " << observer.getName() << " subscribed to " << eventType << " (handle)" << std::endl;
+        return list->subscribe(observer);
     }
     
-    std::string getName() const override {
-        return name;
+    void subscribe(std::string_view eventType, std::shared_ptr<EventObserver> observer) {
+        listFor(EventTypeRegistry::instance().intern(eventType)).push_back(observer);
+        std::cout << "Observer " << observer->getName() << " subscribed to " << eventType << std::endl;
+    }
+    
+    void unsubscribe(std::string_view eventType, std::shared_ptr<EventObserver> observer) {
+        // A name nobody subscribed to is not registered just to be removed
+        const auto type = EventTypeRegistry::instance().find(eventType);
+        if (!type || *type >= subscribers.size()) {
+            return;
+        }
+        auto& eventSubscribers = subscribers[*type];
+        auto it = std::find(eventSubscribers.begin(), eventSubscribers.end(), observer);
+        if (it != eventSubscribers.end()) {
+            eventSubscribers.erase(it);
+            std::cout << "Observer " << observer->getName() << " unsubscribed from " << eventType << std::endl;
+        }
+    }
+    
+    void publish(const Event& event) {
+        const EventTypeId type = event.getTypeId();
+        const size_t owned = type < subscribers.size() ? subscribers[type].size() : 0;
+        const ObserverList<EventObserver>* list = handleListFor(type);
+        const size_t handles = list ? list->size() : 0;
+        if (owned + handles == 0) {
+            return;
+        }
+        std::cout << "Publishing event: " << event.getType() << " to " << owned + handles << " subscribers" << std::endl;
+        if (owned > 0) {
+            for (auto& observer : subscribers[type]) {
+                observer->onEvent(event);
+            }
+        }
+        if (list) {
+            list->notify([&event](EventObserver& observer) { observer.onEvent(event); });
+        }
     }
     
 private:
-    std::string name;
+    std::vector<std::shared_ptr<EventObserver>>& listFor(EventTypeId type) {
+        if (type >= subscribers.size()) {
+            subscribers.resize(type + 1);
+        }
+        return subscribers[type];
+    }
+    
+    ObserverList<EventObserver>* handleListFor(EventTypeId type) const noexcept {
+        const auto* slot = handleLists.find(type);
+        return slot ? slot->load(std::memory_order_acquire) : nullptr;
+    }
+    
+    std::vector<std::vector<std::shared_ptr<EventObserver>>> subscribers;
+    // Lock-free reads from publish(); created under listsMutex
+    SegmentedArray<std::atomic<ObserverList<EventObserver>*>> handleLists;
+    std::vector<std::unique_ptr<ObserverList<EventObserver>>> ownedHandleLists;
+    std::mutex listsMutex;
 };
 
-class ForecastDisplay : public Observer {
+inline void cpuRelax() noexcept {
+#if defined(__SSE2__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Bounded lock-free multi-producer/multi-consumer ring (Vyukov's design):
+// each cell carries a sequence number that tells producers and consumers
+// whether it is free for lap N, so a push or pop is one CAS on the shared
+// position plus one release store on the cell.
+template<typename T>
+class MpmcRing {
 public:
-    ForecastDisplay(const std::string& name) : name(name) {}
+    explicit MpmcRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size *= 2;
+        }
+        cells_ = std::make_unique<Cell[]>(size);
+        mask_ = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
     
-    void update(const std::string& message) override {
-        std::cout << "[" << name << "] Forecast updated: " << message << std::endl;
-        // In a real implementation, this would generate weather forecasts
+    // Only called once producers and consumers are gone
+    ~MpmcRing() {
+        const size_t end = enqueuePosition_.load(std::memory_order_relaxed);
+        for (size_t position = dequeuePosition_.load(std::memory_order_relaxed); position != end; ++position) {
+            std::launder(reinterpret_cast<T*>(cells_[position & mask_].storage))->~T();
+        }
     }
     
-    std::string getName() const override {
-        return name;
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+    
+    bool tryPush(T&& value) {
+        size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto lap = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (lap == 0) {
+                if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    ::new (static_cast<void*>(cell.storage)) T(std::move(value));
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lap < 0) {
+                return false; // full
+            } else {
+                position = enqueuePosition_.load(std::memory_order_relaxed);
+            }
+        }
     }
     
+    bool tryPop(T& out) {
+        size_t position = dequeuePosition_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto lap = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (lap == 0) {
+                if (dequeuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    T* item = std::launder(reinterpret_cast<T*>(cell.storage));
+                    out = std::move(*item);
+                    item->~T();
+                    cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lap < 0) {
+                return false; // empty
+            } else {
+                position = dequeuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    // Pushes claimed so far (some may still be completing)
+    [[nodiscard]] size_t enqueued() const noexcept {
+        return enqueuePosition_.load(std::memory_order_acquire);
+    }
+
 private:
-    std::string name;
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> enqueuePosition_{0};
+    alignas(64) std::atomic<size_t> dequeuePosition_{0};
 };
 
-// Modern Observer using std::function (C++11 approach)
-class ModernSubject {
+// Concurrent event bus
+// - a type interned on the bus gets one of its own dense topic slots; a
+//   lock-free table maps the process-wide EventTypeRegistry id to that slot,
+//   so an event's own type id routes it without any string handling and the
+//   topic cap counts only this bus's topics
+// - each type (topic) has its own bounded MPMC ring; publish() is one
+//   lock-free push and never touches subscriber state
+// - dispatcher threads own topics (slot % dispatchers), pop events in
+//   batches and hand each batch to every subscriber via onEvents(), so
+//   per-topic order is preserved
+// - an idle dispatcher spins briefly, then parks on a condition variable;
+//   publishers pay for a wake-up only while their topic's dispatcher is
+//   parked
+// - subscriber lists are immutable snapshots swapped in with an atomic
+//   pointer (RCU style); subscribe/unsubscribe copy the list, publish the new
+//   one and free the old after every dispatcher has left its read section.
+//   Called from onEvents() on one of this bus's dispatchers, they cannot wait
+//   for that, so the old list is parked until the next update from another
+//   thread (or the bus's destruction) frees it.
+// An observer subscribed to topics owned by different dispatchers may be
+// called from several threads at once.
+class EventBus {
 public:
-    using ObserverCallback = std::function<void(const std::string&)>;
+    struct Options {
+        size_t dispatchers = 1;
+        size_t ringCapacity = 4096; // per topic, rounded up to a power of two
+        size_t batchSize = 64;
+        size_t maxTopics = 256;     // distinct types this bus can carry
+    };
     
-    void attach(const std::string& name, ObserverCallback callback) {
-        observers[name] = std::move(callback);
-        std::cout << "Observer " << name << " attached (modern)" << std::endl;
+    EventBus() : EventBus(Options{}) {}
+    
+    explicit EventBus(Options options)
+        : options_(options), topics_(std::make_unique<Topic[]>(options.maxTopics)),
+          dispatchers_(std::max<size_t>(1, options.dispatchers)) {
+        for (size_t i = 0; i < dispatchers_.size(); ++i) {
+            dispatchers_[i].thread = std::thread([this, i] { dispatchLoop(i); });
+        }
     }
     
-    void detach(const std::string& name) {
-        if (observers.erase(name) > 0) {
-            std::cout << "Observer " << name << " detached (modern)" << std::endl;
+    // Delivers everything already published, then stops the dispatchers
+    ~EventBus() {
+        stopping_.store(true, std::memory_order_seq_cst);
+        for (auto& dispatcher : dispatchers_) {
+            wake(dispatcher);
+        }
+        for (auto& dispatcher : dispatchers_) {
+            dispatcher.thread.join();
+        }
+        for (size_t i = 0; i < topicCount_.load(std::memory_order_acquire); ++i) {
+            delete topics_[i].subscribers.load(std::memory_order_relaxed);
+        }
+        for (const SubscriberList* list : deferred_) {
+            delete list;
         }
     }
     
-    void notify(const std::string& message) {
-        std::cout << "Modern Subject: Notifying " << observers.size() << " observers" << std::endl;
-        for (auto& [name, callback] : observers) {
-            callback(message);
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+    
+    // Returns the id for a type name, creating this bus's topic on first use
+    EventTypeId internType(std::string_view type) {
+        const EventTypeId id = EventTypeRegistry::instance().intern(type);
+        std::lock_guard<std::mutex> lock(controlMutex_);
+        std::atomic<Topic*>& slot = topicByType_.ensure(id);
+        if (slot.load(std::memory_order_relaxed)) {
+            return id;
+        }
+        const size_t index = topicCount_.load(std::memory_order_relaxed);
+        if (index >= options_.maxTopics) {
+            throw std::length_error("EventBus topic limit reached");
         }
+        Topic& topic = topics_[index];
+        topic.ring = std::make_unique<MpmcRing<Event>>(options_.ringCapacity);
+        topic.subscribers.store(new SubscriberList(), std::memory_order_relaxed);
+        topic.dispatcher = &dispatchers_[index % dispatchers_.size()];
+        topicCount_.store(index + 1, std::memory_order_release);
+        slot.store(&topic, std::memory_order_release);
+        return id;
     }
     
-    void setData(const std::string& data) {
-        this->data = data;
-        notify("Data changed to: " + data);
+    // Lock-free; routed by event.getTypeId(), which must come from
+    // internType() on this bus, otherwise std::out_of_range is thrown.
+    // Returns false if the topic's ring is full.
+    bool tryPublish(Event event) {
+        Topic& topic = activeTopic(event.getTypeId());
+        if (!topic.ring->tryPush(std::move(event))) {
+            return false;
+        }
+        wakeIfParked(*topic.dispatcher);
+        return true;
     }
     
-private:
-    std::map<std::string, ObserverCallback> observers;
-    std::string data;
-};
-
-// Event-driven Observer Pattern
-class Event {
-public:
-    Event(const std::string& type, const std::string& data) 
-        : type(type), data(data), timestamp(std::time(nullptr)) {}
+    // Retries with backoff while the ring is full
+    void publish(Event event) {
+        Topic& topic = activeTopic(event.getTypeId());
+        for (unsigned attempt = 0; !topic.ring->tryPush(std::move(event)); ++attempt) {
+            if (attempt < 16) {
+                cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        wakeIfParked(*topic.dispatcher);
+    }
     
-    std::string getType() const { return type; }
-    std::string getData() const { return data; }
-    std::time_t getTimestamp() const { return timestamp; }
+    void subscribe(EventTypeId type, std::shared_ptr<EventObserver> observer) {
+        updateSubscribers(type, [&](SubscriberList& list) { list.push_back(std::move(observer)); });
+    }
     
-private:
-    std::string type;
-    std::string data;
-    std::time_t timestamp;
-};
-
-class EventObserver {
-public:
-    virtual ~EventObserver() = default;
-    virtual void onEvent(const Event& event) = 0;
-    virtual std::string getName() const = 0;
-};
+    void unsubscribe(EventTypeId type, const std::shared_ptr<EventObserver>& observer) {
+        updateSubscribers(type, [&](SubscriberList& list) {
+            list.erase(std::remove(list.begin(), list.end(), observer), list.end());
+        });
+    }
+    
+    // Blocks until every event published before the call has been delivered
+    void flush() {
+        const size_t topicCount = topicCount_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < topicCount; ++i) {
+            const size_t target = topics_[i].ring->enqueued();
+            while (topics_[i].delivered.load(std::memory_order_acquire) < target) {
+                std::this_thread::yield();
+            }
+        }
+    }
 
-class EventSubject {
-public:
-    void subscribe(const std::string& eventType, std::shared_ptr<EventObserver> observer) {
-        subscribers[eventType].push_back(observer);
-        std::cout << "Observer " << observer->getName() << " subscribed to " << eventType << std::endl;
+private:
+    using SubscriberList = std::vector<std::shared_ptr<EventObserver>>;
+    
+    struct Dispatcher {
+        std::thread thread;
+        // Odd while inside a read section, even otherwise
+        alignas(64) std::atomic<uint64_t> readEpoch{0};
+        alignas(64) std::atomic<bool> parked{false};
+        std::mutex parkMutex;
+        std::condition_variable wakeUp;
+    };
+    
+    struct alignas(64) Topic {
+        std::unique_ptr<MpmcRing<Event>> ring;
+        std::atomic<const SubscriberList*> subscribers{nullptr};
+        std::atomic<size_t> delivered{0};
+        Dispatcher* dispatcher = nullptr;
+    };
+    
+    Topic& activeTopic(EventTypeId type) {
+        const std::atomic<Topic*>* slot = topicByType_.find(type);
+        Topic* topic = slot ? slot->load(std::memory_order_acquire) : nullptr;
+        if (!topic) {
+            throw std::out_of_range("EventBus topic was not interned on this bus");
+        }
+        return *topic;
     }
     
-    void unsubscribe(const std::string& eventType, std::shared_ptr<EventObserver> observer) {
-        auto& eventSubscribers = subscribers[eventType];
-        auto it = std::find(eventSubscribers.begin(), eventSubscribers.end(), observer);
-        if (it != eventSubscribers.end()) {
-            eventSubscribers.erase(it);
-            std::cout << "Observer " << observer->getName() << " unsubscribed from " << eventType << std::endl;
+    // The fence orders the push before the parked check; the dispatcher
+    // fences between setting parked and rechecking its rings, so one of the
+    // two always sees the other
+    void wakeIfParked(Dispatcher& dispatcher) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (dispatcher.parked.load(std::memory_order_relaxed)) {
+            wake(dispatcher);
         }
     }
     
-    void publish(const Event& event) {
-        auto it = subscribers.find(event.getType());
-        if (it != subscribers.end()) {
-            std::cout << "Publishing event: " << event.getType() << " to " << it->second.size() << " subscribers" << std::endl;
-            for (auto& observer : it->second) {
-                observer->onEvent(event);
+    void wake(Dispatcher& dispatcher) {
+        {
+            std::lock_guard<std::mutex> lock(dispatcher.parkMutex);
+            dispatcher.parked.store(false, std::memory_order_relaxed);
+        }
+        dispatcher.wakeUp.notify_one();
+    }
+    
+    // The grace period runs outside controlMutex_, so an observer may
+    // subscribe from onEvents() while another thread is waiting on it
+    template<typename Update>
+    void updateSubscribers(EventTypeId type, Update&& update) {
+        std::vector<const SubscriberList*> garbage;
+        {
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            Topic& topic = activeTopic(type);
+            const SubscriberList* old = topic.subscribers.load(std::memory_order_relaxed);
+            auto next = std::make_unique<SubscriberList>(*old);
+            update(*next);
+            if (dispatchingBus_ == this) {
+                // Waiting here would wait on this very read section
+                deferred_.push_back(old);
+                topic.subscribers.store(next.release(), std::memory_order_seq_cst);
+                return;
             }
+            garbage.reserve(deferred_.size() + 1);
+            topic.subscribers.store(next.release(), std::memory_order_seq_cst);
+            // Parked lists were unpublished before this store, so the same
+            // grace period covers them
+            garbage.assign(deferred_.begin(), deferred_.end());
+            garbage.push_back(old);
+            deferred_.clear();
+        }
+        waitForReaders();
+        for (const SubscriberList* list : garbage) {
+            delete list;
         }
     }
     
-private:
-    std::map<std::string, std::vector<std::shared_ptr<EventObserver>>> subscribers;
+    // Grace period: every dispatcher that was mid-read when the new list
+    // was published must finish that read section before the old list goes
+    void waitForReaders() {
+        for (auto& dispatcher : dispatchers_) {
+            const uint64_t epoch = dispatcher.readEpoch.load(std::memory_order_seq_cst);
+            if (epoch % 2 == 0) {
+                continue;
+            }
+            while (dispatcher.readEpoch.load(std::memory_order_seq_cst) == epoch) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    
+    // True when one of the dispatcher's topics holds undelivered events
+    bool hasPending(size_t index) const {
+        const size_t topicCount = topicCount_.load(std::memory_order_acquire);
+        for (size_t i = index; i < topicCount; i += dispatchers_.size()) {
+            if (topics_[i].ring->enqueued() != topics_[i].delivered.load(std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void park(size_t index) {
+        Dispatcher& self = dispatchers_[index];
+        self.parked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (stopping_.load(std::memory_order_relaxed) || hasPending(index)) {
+            self.parked.store(false, std::memory_order_relaxed);
+            return;
+        }
+        std::unique_lock<std::mutex> lock(self.parkMutex);
+        self.wakeUp.wait(lock, [&] { return !self.parked.load(std::memory_order_relaxed); });
+    }
+    
+    void dispatchLoop(size_t index) {
+        dispatchingBus_ = this;
+        Dispatcher& self = dispatchers_[index];
+        std::vector<Event> batch;
+        batch.reserve(options_.batchSize);
+        unsigned idleRounds = 0;
+        for (;;) {
+            const bool stopping = stopping_.load(std::memory_order_acquire);
+            const size_t topicCount = topicCount_.load(std::memory_order_acquire);
+            bool delivered = false;
+            for (size_t i = index; i < topicCount; i += dispatchers_.size()) {
+                Topic& topic = topics_[i];
+                Event event;
+                while (batch.size() < options_.batchSize && topic.ring->tryPop(event)) {
+                    batch.push_back(std::move(event));
+                }
+                if (batch.empty()) {
+                    continue;
+                }
+                self.readEpoch.fetch_add(1, std::memory_order_seq_cst);
+                const SubscriberList* subscribers = topic.subscribers.load(std::memory_order_seq_cst);
+                for (const auto& observer : *subscribers) {
+                    observer->onEvents(batch.data(), batch.size());
+                }
+                self.readEpoch.fetch_add(1, std::memory_order_release);
+                topic.delivered.fetch_add(batch.size(), std::memory_order_release);
+                batch.clear();
+                delivered = true;
+            }
+            if (delivered) {
+                idleRounds = 0;
+                continue;
+            }
+            if (stopping) {
+                return;
+            }
+            // Spin briefly for a burst to continue, then sleep until woken
+            if (++idleRounds < 64) {
+                cpuRelax();
+            } else if (idleRounds < 128) {
+                std::this_thread::yield();
+            } else {
+                park(index);
+                idleRounds = 0;
+            }
+        }
+    }
+    
+    Options options_;
+    std::unique_ptr<Topic[]> topics_;           // dense, in intern order
+    std::atomic<size_t> topicCount_{0};
+    SegmentedArray<std::atomic<Topic*>> topicByType_; // registry id -> topic
+    std::vector<Dispatcher> dispatchers_;
+    std::atomic<bool> stopping_{false};
+    
+    std::mutex controlMutex_; // intern/subscribe/unsubscribe only
+    std::vector<const SubscriberList*> deferred_; // guarded by controlMutex_
+    
+    // Set on dispatcher threads to the bus they serve
+    inline static thread_local const EventBus* dispatchingBus_ = nullptr;
 };
 
 class LoggingObserver : public EventObserver {
@@ -228,10 +1943,11 @@ private:
 
 class AlertingObserver : public EventObserver {
 public:
-    AlertingObserver(const std::string& name) : name(name) {}
+    AlertingObserver(const std::string& name)
+        : name(name), errorType(EventTypeRegistry::instance().intern("ERROR")) {}
     
     void onEvent(const Event& event) override {
-        if (event.getType() == "ERROR") {
+        if (event.getTypeId() == errorType) {
             std::cout << "[" << name << "] ALERT: " << event.getData() << std::endl;
         }
     }
@@ -242,6 +1958,7 @@ public:
     
 private:
     std::string name;
+    EventTypeId errorType;
 };
 
 int main() {
@@ -266,6 +1983,196 @@ int main() {
     weatherStation->detach(statisticsDisplay);
     weatherStation->setMeasurements(24.8f, 60.0f, 1014.00f);
     
+    // Handle-based subscription: not owned, detached when the token dies
+    {
+        CurrentConditionsDisplay lobbyDisplay("Lobby Display");
+        Subscription token = weatherStation->subscribe(lobbyDisplay);
+        weatherStation->setMeasurements(23.9f, 58.0f, 1014.50f);
+    }
+    weatherStation->setMeasurements(23.5f, 57.0f, 1015.00f);
+    
+    // Typed measurements through a per-observer mailbox
+    std::cout << "\n--- Mailbox Measurement Delivery ---" << std::endl;
+    {
+        WeatherStation station;
+        DeliveryOptions latestOnly;
+        latestOnly.mode = DeliveryOptions::Mode::Latest;
+        station.subscribeMeasurements(currentDisplay, latestOnly);
+        station.setMeasurements(25.5f, 65.0f, 1013.25f);
+        station.drainMeasurements();
+        station.setMeasurements(26.2f, 70.0f, 1012.50f);
+        station.drainMeasurements();
+        station.unsubscribeMeasurements(currentDisplay);
+        
+        station.subscribeMeasurements(statisticsDisplay);
+        for (int i = 0; i < 10; ++i) {
+            station.setMeasurements(20.0f + i * 0.5f, 60.0f + i, 1010.0f + i * 0.25f);
+        }
+        station.drainMeasurements();
+        statisticsDisplay->printStatistics();
+    }
+    
+    // 100 kHz producer feeding observers of very different speeds
+    std::cout << "\n--- Mailbox Delivery Benchmark ---" << std::endl;
+    {
+        class TimedObserver : public MeasurementObserver {
+        public:
+            TimedObserver(std::string name, std::chrono::microseconds work, bool sleeps)
+                : name(std::move(name)), work(work), sleeps(sleeps) {}
+            
+            void onMeasurement(const Measurement& measurement) override {
+                const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+                totalStalenessNs += now - measurement.timestampNs;
+                maxStalenessNs = std::max(maxStalenessNs, now - measurement.timestampNs);
+                if (sleeps) {
+                    std::this_thread::sleep_for(work);
+                } else {
+                    const auto until = std::chrono::steady_clock::now() + work;
+                    while (std::chrono::steady_clock::now() < until) {
+                    }
+                }
+            }
+            
+            std::string getName() const override { return name; }
+            
+            int64_t totalStalenessNs = 0;
+            int64_t maxStalenessNs = 0;
+            
+        private:
+            std::string name;
+            std::chrono::microseconds work;
+            bool sleeps;
+        };
+        
+        using namespace std::chrono_literals;
+        struct Setup {
+            std::shared_ptr<TimedObserver> observer;
+            DeliveryOptions options;
+        };
+        std::vector<Setup> setups;
+        setups.push_back({std::make_shared<TimedObserver>("Recorder (queue, no work)", 0us, false), {}});
+        setups.back().options.mailboxCapacity = 8192;
+        setups.push_back({std::make_shared<TimedObserver>("Archiver (queue, 50us busy)", 50us, false), {}});
+        setups.push_back({std::make_shared<TimedObserver>("Analytics (latest, 2ms sleep)", 2000us, true), {}});
+        setups.back().options.mode = DeliveryOptions::Mode::Latest;
+        setups.push_back({std::make_shared<TimedObserver>("Dashboard (latest, 30 Hz)", 0us, false), {}});
+        setups.back().options.mode = DeliveryOptions::Mode::Latest;
+        setups.back().options.maxRateHz = 30.0;
+        
+        // Synchronous baseline: one string notify per update, inline work
+        {
+            constexpr size_t updates = 200;
+            size_t sink = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < updates; ++i) {
+                std::string message = "Temperature: " + std::to_string(20.0f + i) +
+                                     "°C, Humidity: " + std::to_string(50.0f) +
+                                     "%, Pressure: " + std::to_string(1013.0f) + " hPa";
+                sink += message.size();
+                Measurement measurement{20.0f + i, 50.0f, 1013.0f, i, 0};
+                for (auto& setup : setups) {
+                    setup.observer->onMeasurement(measurement);
+                }
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "Synchronous notify: max " << static_cast<size_t>(updates / seconds)
+                      << " updates/s with these observers (" << sink << " bytes formatted)" << std::endl;
+            for (auto& setup : setups) {
+                setup.observer->totalStalenessNs = 0;
+                setup.observer->maxStalenessNs = 0;
+            }
+        }
+        
+        constexpr size_t rateHz = 100'000;
+        constexpr size_t perTick = rateHz / 1000; // paced in 1 ms ticks
+        constexpr size_t ticks = 1000;
+        WeatherStation station;
+        for (auto& setup : setups) {
+            station.subscribeMeasurements(setup.observer, setup.options);
+        }
+        std::vector<uint32_t> latencies;
+        latencies.reserve(ticks * perTick);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t tick = 0; tick < ticks; ++tick) {
+            std::this_thread::sleep_until(start + std::chrono::milliseconds(tick));
+            for (size_t i = 0; i < perTick; ++i) {
+                const float t = 20.0f + static_cast<float>((tick * perTick + i) % 100) * 0.01f;
+                auto begin = std::chrono::steady_clock::now();
+                station.setMeasurements(t, 55.0f, 1013.0f);
+                latencies.push_back(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - begin).count()));
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        station.drainMeasurements();
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << "Produced " << latencies.size() << " samples at " << static_cast<size_t>(latencies.size() / seconds)
+                  << "/s, setMeasurements p50/p99 ns: " << latencies[latencies.size() / 2] << " / "
+                  << latencies[latencies.size() * 99 / 100] << std::endl;
+        std::cout << "Hardware threads: " << std::max(1u, std::thread::hardware_concurrency()) << std::endl;
+        for (auto& setup : setups) {
+            auto stats = station.measurementStats(setup.observer);
+            std::cout << "  " << setup.observer->getName() << ": " << stats.delivered << " delivered, "
+                      << stats.coalesced << " coalesced, " << stats.dropped << " dropped, staleness mean/max us: "
+                      << (stats.delivered ? setup.observer->totalStalenessNs / static_cast<int64_t>(stats.delivered) / 1000 : 0)
+                      << " / " << setup.observer->maxStalenessNs / 1000 << std::endl;
+        }
+    }
+    
+    // Incremental statistics vs recomputing over the stored history
+    std::cout << "\n--- Incremental Statistics Benchmark ---" << std::endl;
+    {
+        constexpr size_t samples = 5'000'000;
+        constexpr int64_t intervalNs = 10'000; // 100 kHz sensor
+        std::vector<double> history;
+        history.reserve(samples);
+        uint64_t state = 88172645463325252ull;
+        auto nextValue = [&state](size_t i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            // Slow daily cycle plus noise with an occasional spike
+            const double noise = static_cast<double>(state % 10'000) / 10'000.0 - 0.5;
+            const double spike = state % 1000 == 0 ? 15.0 : 0.0;
+            return 20.0 + 5.0 * std::sin(static_cast<double>(i) * 1e-6) + noise + spike;
+        };
+        
+        ChannelStatistics channel(std::chrono::seconds(10));
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < samples; ++i) {
+            const double value = nextValue(i);
+            history.push_back(value);
+            channel.add(static_cast<int64_t>(i) * intervalNs, value);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Incremental update: " << seconds * 1e9 / samples << " ns/sample ("
+                  << static_cast<size_t>(samples / seconds / 1e6 * 60) << "M samples/min), retained "
+                  << channel.getDigest().centroidCount() << " centroids + "
+                  << channel.getWindow().retainedBuckets() << " window entries" << std::endl;
+        
+        // Exact answers by recomputing over the full history
+        start = std::chrono::steady_clock::now();
+        std::vector<double> sorted = history;
+        const size_t windowSamples = static_cast<size_t>(10'000'000'000 / intervalNs);
+        auto windowBegin = history.end() - static_cast<std::ptrdiff_t>(windowSamples);
+        double windowMax = *std::max_element(windowBegin, history.end());
+        std::sort(sorted.begin(), sorted.end());
+        double recomputeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        
+        start = std::chrono::steady_clock::now();
+        double p50 = channel.getDigest().quantile(0.5);
+        double p99 = channel.getDigest().quantile(0.99);
+        double p999 = channel.getDigest().quantile(0.999);
+        double queryUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        auto exact = [&](double q) { return sorted[static_cast<size_t>(q * (sorted.size() - 1))]; };
+        std::cout << "Query: incremental " << queryUs << " us vs recompute " << recomputeMs << " ms" << std::endl;
+        std::cout << "p50 " << p50 << " (exact " << exact(0.5) << "), p99 " << p99 << " (exact " << exact(0.99)
+                  << "), p99.9 " << p999 << " (exact " << exact(0.999) << ")" << std::endl;
+        std::cout << "Mean " << channel.getMoments().mean() << ", sd " << channel.getMoments().stddev()
+                  << ", 10 s window max " << channel.getWindow().max() << " (exact " << windowMax << ")" << std::endl;
+    }
+    
     // Modern Observer Pattern with std::function
     std::cout << "\n--- Modern Observer Pattern ---" << std::endl;
     
@@ -305,5 +2212,286 @@ int main() {
     eventSubject.unsubscribe("ERROR", alertingObserver);
     eventSubject.publish(Event("ERROR", "Another error occurred"));
     
+    {
+        AlertingObserver pager("Pager");
+        Subscription token = eventSubject.subscribe("ERROR", pager);
+        eventSubject.publish(Event("ERROR", "Replica lag above threshold"));
+    }
+    eventSubject.publish(Event("ERROR", "Pager already detached"));
+    
+    // Notifications racing attach/detach; observers retire right after detach
+    std::cout << "\n--- Subscription Churn Stress Test ---" << std::endl;
+    {
+        static std::atomic<uint64_t> violations{0};
+        
+        class CountingObserver : public Observer {
+        public:
+            // Stands in for destruction: the object stays allocated until the
+            // test ends, so a late call is counted instead of reading freed memory
+            void retire() { alive.store(false); }
+            void update(const std::string&) override {
+                if (!alive.load()) {
+                    violations.fetch_add(1);
+                }
+                calls.fetch_add(1, std::memory_order_relaxed);
+            }
+            std::string getName() const override { return "Counter"; }
+            
+            std::atomic<bool> alive{true};
+            std::atomic<uint64_t> calls{0};
+        };
+        
+        // Detaches itself from inside its third notification
+        class SelfDetachingObserver : public CountingObserver {
+        public:
+            void update(const std::string& message) override {
+                CountingObserver::update(message);
+                if (armed.load(std::memory_order_acquire) && ++armedCalls == 3) {
+                    token.reset();
+                }
+            }
+            
+            Subscription token;
+            std::atomic<bool> armed{false};
+            std::atomic<int> armedCalls{0};
+        };
+        
+        ObserverList<Observer> list;
+        std::vector<std::unique_ptr<CountingObserver>> stable;
+        std::vector<Subscription> stableTokens;
+        for (int i = 0; i < 8; ++i) {
+            stable.push_back(std::make_unique<CountingObserver>());
+            stableTokens.push_back(list.subscribe(*stable.back()));
+        }
+        std::vector<std::unique_ptr<SelfDetachingObserver>> selfDetaching;
+        for (int i = 0; i < 64; ++i) {
+            selfDetaching.push_back(std::make_unique<SelfDetachingObserver>());
+            selfDetaching.back()->token = list.subscribe(*selfDetaching.back());
+            selfDetaching.back()->armed.store(true, std::memory_order_release);
+        }
+        
+        const size_t notifiers = 2;
+        const size_t churners = 2;
+        const std::string message = "tick";
+        std::atomic<bool> stop{false};
+        std::atomic<uint64_t> rounds{0};
+        std::atomic<uint64_t> churnCycles{0};
+        std::atomic<uint64_t> staleHandleHits{0};
+        std::vector<std::vector<std::unique_ptr<CountingObserver>>> retiredObservers(churners);
+        std::vector<std::thread> threads;
+        for (size_t n = 0; n < notifiers; ++n) {
+            threads.emplace_back([&] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    list.notify([&message](Observer& observer) { observer.update(message); });
+                    rounds.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (size_t c = 0; c < churners; ++c) {
+            threads.emplace_back([&, c] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    auto observer = std::make_unique<CountingObserver>();
+                    Subscription token = list.subscribe(*observer);
+                    const SubscriptionHandle stale = token.getHandle();
+                    std::this_thread::yield();
+                    token.reset();
+                    // Detach waited for in-flight notifications; none may follow
+                    observer->retire();
+                    retiredObservers[c].push_back(std::move(observer));
+                    // A stale handle must never detach whoever reuses the slot
+                    if (list.detach(stale) || list.contains(stale)) {
+                        staleHandleHits.fetch_add(1);
+                    }
+                    churnCycles.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        auto start = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        stop.store(true);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        bool stableExact = true;
+        for (const auto& observer : stable) {
+            stableExact = stableExact && observer->calls.load() == rounds.load();
+        }
+        size_t stillAttached = 0;
+        for (const auto& observer : selfDetaching) {
+            stillAttached += observer->token.active() ? 1 : 0;
+        }
+        const bool ok = violations.load() == 0 && staleHandleHits.load() == 0 &&
+                        stableExact && stillAttached == 0 && list.size() == stable.size();
+        std::cout << notifiers << " notifiers, " << churners << " churners (hardware threads: "
+                  << std::max(1u, std::thread::hardware_concurrency()) << "): "
+                  << static_cast<size_t>(rounds.load() / seconds) << " notify rounds/s, "
+                  << static_cast<size_t>(churnCycles.load() / seconds) << " attach/detach cycles/s" << std::endl;
+        std::cout << "Calls after detach: " << violations.load()
+                  << ", stale handle hits: " << staleHandleHits.load()
+                  << ", stable observers saw every round: " << (stableExact ? "yes" : "no")
+                  << ", self-detached: " << selfDetaching.size() - stillAttached << "/" << selfDetaching.size()
+                  << " -> " << (ok ? "OK" : "FAILED") << std::endl;
+    }
+    
+    // Concurrent event bus: same observers, asynchronous batched delivery
+    std::cout << "\n--- Concurrent Event Bus ---" << std::endl;
+    {
+        EventBus bus;
+        const EventTypeId info = bus.internType("INFO");
+        const EventTypeId error = bus.internType("ERROR");
+        bus.subscribe(info, loggingObserver);
+        bus.subscribe(error, loggingObserver);
+        bus.subscribe(error, alertingObserver);
+        
+        bus.publish(Event(info, "Bus online"));
+        bus.publish(Event(error, "Disk quota exceeded"));
+        bus.flush();
+        
+        bus.unsubscribe(error, alertingObserver);
+        bus.publish(Event(error, "Delivered to the logger only"));
+        bus.flush();
+    }
+    
+    // Heap allocations per event: build, queue (copy) and consume
+    std::cout << "\n--- Event Allocation Benchmark ---" << std::endl;
+    {
+        // The previous representation: two strings, copying getters. The
+        // strings draw from a CountingResource so every allocation is seen.
+        class StringEvent {
+        public:
+            StringEvent(std::string_view type, std::string_view data, std::pmr::memory_resource* resource)
+                : type(type, resource), data(data, resource), timestamp(std::time(nullptr)) {}
+            StringEvent(const StringEvent& other)
+                : type(other.type, other.type.get_allocator()), data(other.data, other.data.get_allocator()),
+                  timestamp(other.timestamp) {}
+            std::pmr::string getType() const { return {type, type.get_allocator()}; }
+            std::pmr::string getData() const { return {data, data.get_allocator()}; }
+        private:
+            std::pmr::string type;
+            std::pmr::string data;
+            std::time_t timestamp;
+        };
+        CountingResource stringMemory;
+        // The queue draws from its own CountingResource, so each row counts
+        // every allocation on the path: queue, strings or payload pool. Event
+        // payloads either sit inline or come from EventPayloadPool.
+        CountingResource queueMemory;
+        auto stringAllocations = [&] { return queueMemory.allocations() + stringMemory.allocations(); };
+        auto poolAllocations = [&] { return queueMemory.allocations() + EventPayloadPool::upstreamAllocations(); };
+        
+        constexpr size_t events = 100'000;
+        const std::string typeName = "SENSOR_READING_UPDATED";
+        // Interned up front: looking up a known name never allocates, so the
+        // by-name row measures the lookup, not the one-time registration
+        const EventTypeId typeId = EventTypeRegistry::instance().intern(typeName);
+        const std::string shortData = "temperature=25.5 humidity=65";
+        const std::string longData(200, 'x');
+        
+        auto measure = [&](const char* name, auto&& allocationsSoFar, auto&& makeEvent) {
+            using EventType = std::decay_t<decltype(makeEvent())>;
+            const size_t before = allocationsSoFar();
+            std::pmr::vector<EventType> queue(&queueMemory);
+            queue.reserve(events);
+            size_t checksum = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < events; ++i) {
+                EventType event = makeEvent();
+                queue.push_back(event); // a subject/bus keeps its own copy
+                checksum += queue.back().getType().size() + queue.back().getData().size();
+            }
+            queue.clear();
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            const size_t allocations = allocationsSoFar() - before;
+            std::cout << name << ": " << static_cast<double>(allocations) / events << " allocations/event, "
+                      << ns / events << " ns/event (checksum " << checksum << ")" << std::endl;
+        };
+        
+        measure("std::string event, 28 B payload", stringAllocations,
+                [&] { return StringEvent(typeName, shortData, &stringMemory); });
+        measure("std::string event, 200 B payload", stringAllocations,
+                [&] { return StringEvent(typeName, longData, &stringMemory); });
+        measure("Compact event by name, 28 B inline", poolAllocations, [&] { return Event(typeName, shortData); });
+        measure("Compact event by id, 28 B inline", poolAllocations, [&] { return Event(typeId, shortData); });
+        measure("Compact event by id, 200 B pooled", poolAllocations, [&] { return Event(typeId, longData); });
+        // The old layout used plain std::strings, which carry no resource pointer
+        const size_t stringEventBytes = 2 * sizeof(std::string) + sizeof(std::time_t);
+        std::cout << "sizeof(Event): " << sizeof(Event) << " bytes (was " << stringEventBytes << ")" << std::endl;
+    }
+    
+    // Events/sec and caller-side publish latency as publishers scale
+    std::cout << "\n--- Event Bus Benchmark ---" << std::endl;
+    {
+        class CountingObserver : public EventObserver {
+        public:
+            void onEvent(const Event&) override { ++count_; }
+            void onEvents(const Event*, size_t count) override { count_ += count; }
+            std::string getName() const override { return "Counter"; }
+            size_t count() const { return count_; }
+        private:
+            size_t count_ = 0; // each topic is served by a single dispatcher
+        };
+        
+        constexpr size_t topics = 8;
+        constexpr size_t totalEvents = 1'000'000;
+        constexpr size_t sampleEvery = 64;
+        std::cout << "Hardware threads: " << std::max(1u, std::thread::hardware_concurrency()) << std::endl;
+        
+        for (size_t publishers : {1, 2, 4, 8, 16, 32}) {
+            EventBus::Options options;
+            options.dispatchers = 2;
+            options.ringCapacity = 16384;
+            EventBus bus(options);
+            std::vector<EventTypeId> ids;
+            std::vector<std::shared_ptr<CountingObserver>> counters;
+            for (size_t t = 0; t < topics; ++t) {
+                ids.push_back(bus.internType("TOPIC_" + std::to_string(t)));
+                counters.push_back(std::make_shared<CountingObserver>());
+                bus.subscribe(ids.back(), counters.back());
+            }
+            
+            const size_t perPublisher = totalEvents / publishers;
+            std::vector<std::vector<uint32_t>> samples(publishers);
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (size_t p = 0; p < publishers; ++p) {
+                threads.emplace_back([&, p] {
+                    samples[p].reserve(perPublisher / sampleEvery + 1);
+                    for (size_t i = 0; i < perPublisher; ++i) {
+                        const EventTypeId id = ids[(p + i) % topics];
+                        if (i % sampleEvery != 0) {
+                            bus.publish(Event(id, "payload"));
+                            continue;
+                        }
+                        auto begin = std::chrono::steady_clock::now();
+                        bus.publish(Event(id, "payload"));
+                        samples[p].push_back(static_cast<uint32_t>(std::min<int64_t>(UINT32_MAX,
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count())));
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            bus.flush();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            
+            size_t delivered = 0;
+            for (const auto& counter : counters) {
+                delivered += counter->count();
+            }
+            std::vector<uint32_t> latencies;
+            for (const auto& perThread : samples) {
+                latencies.insert(latencies.end(), perThread.begin(), perThread.end());
+            }
+            std::sort(latencies.begin(), latencies.end());
+            auto at = [&](double q) { return latencies[static_cast<size_t>(q * (latencies.size() - 1))]; };
+            std::cout << publishers << " publishers: " << static_cast<size_t>(static_cast<double>(delivered) / seconds)
+                      << " events/s, publish p50/p99 ns: " << at(0.5) << " / " << at(0.99)
+                      << " (" << delivered << " delivered)" << std::endl;
+        }
+    }
+    
     return 0;
 } 
\ No newline at end of file
@@ -6,6 +6,10 @@
 #include <numeric>
 #include <variant>
 #include <type_traits>
+#include <cmath>
+#include <string>
+
+#include "callable.hpp"
 
 // Optimized Open/Closed Principle (OCP) Example
 // Using modern C++17/20 features for extensibility and performance
@@ -112,14 +116,16 @@ private:
 // Modern shape calculator using std::variant for type safety
 class ModernShapeCalculator {
 public:
-    // Using std::function for flexible operations
-    using ShapeOperation = std::function<double(const Shape&)>;
+    // Synchronous callback: FunctionRef borrows the callable (lambda,
+    // std::function or plain function) for the duration of the call, with no
+    // allocation
+    using ShapeOperation = FunctionRef<double(const Shape&)>;
     
     void addShape(std::unique_ptr<Shape> shape) {
         shapes_.push_back(std::move(shape));
     }
     
-    // Generic calculation method using std::function
+    // Generic calculation method
     [[nodiscard]] std::vector<double> calculateForAllShapes(ShapeOperation operation) const {
         std::vector<double> results;
         results.reserve(shapes_.size()); // Pre-allocate for better performance
@@ -207,6 +213,12 @@ public:
     }
 };
 
+// Free function passed by name to calculateForAllShapes
+[[nodiscard]] double compactness(const Shape& shape) {
+    const double perimeter = shape.calculatePerimeter();
+    return perimeter > 0.0 ? shape.calculateArea() / (perimeter * perimeter) : 0.0;
+}
+
 int main() {
     std::cout << "=== Optimized Open/Closed Principle (OCP) Example ===" << std::endl;
     
@@ -266,6 +278,12 @@ int main() {
     
     std::cout << "Total area: " << calculator.calculateTotalArea() << std::endl;
     
+    std::cout << "Compactness: ";
+    for (double value : calculator.calculateForAllShapes(compactness)) {
+        std::cout << value << " ";
+    }
+    std::cout << std::endl;
+    
     // Demonstrate modern processing
     ShapeProcessor processor;
     processor.processShapes(std::vector<std::unique_ptr<Shape>>{}, 
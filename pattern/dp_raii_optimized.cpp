@@ -7,6 +7,63 @@
 #include <thread>
 #include <chrono>
 #include <map>
+#include <string_view>
+#include <stdexcept>
+#include <limits>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <algorithm>
+#include <utility>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <random>
+#include <shared_mutex>
+#include <functional>
+#include <condition_variable>
+#include <queue>
+#include <exception>
+#include <atomic>
+#include <ostream>
+#include <iomanip>
+#include <unordered_map>
+
+#include "flat_map.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#define RAII_HAS_POSIX_IO 1
+#else
+#define RAII_HAS_POSIX_IO 0
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Lock contention instrumentation: build with -DRAII_LOCK_PROFILING=0 to
+// compile ProfiledLockGuard down to a plain lock/unlock.
+#ifndef RAII_LOCK_PROFILING
+#define RAII_LOCK_PROFILING 1
+#endif
+
+// Scope tracing: build with -DRAII_TRACING=0 to compile RAII_TRACE_SCOPE out
+#ifndef RAII_TRACING
+#define RAII_TRACING 1
+#endif
 
 // Optimized RAII (Resource Acquisition Is Initialization) Principle Example
 // Using modern C++17/20 features for better performance and safety
@@ -87,7 +144,13 @@ class ModernFileHandler {
 public:
     explicit ModernFileHandler(const std::string& filename) 
         : filename_(filename) {
-        file_.open(filename);
+        file_.open(filename, std::ios::in | std::ios::out);
+        if (!file_.is_open()) {
+            // in|out does not create; app creates a missing file and never
+            // truncates one that appeared in the meantime
+            std::ofstream(filename, std::ios::app);
+            file_.open(filename, std::ios::in | std::ios::out);
+        }
         if (!file_.is_open()) {
             throw std::runtime_error("Failed to open file: " + filename);
         }
@@ -127,8 +190,14 @@ public:
         return "";
     }
     
+    // '\n' instead of std::endl: the stream flushes when its buffer fills,
+    // not on every line. Call flush() when the data must reach the OS.
     void writeLine(const std::string& line) {
-        file_ << line << std::endl;
+        file_ << line << '\n';
+    }
+    
+    void flush() {
+        file_.flush();
     }
     
     [[nodiscard]] bool isOpen() const noexcept {
@@ -149,6 +218,296 @@ private:
     std::string filename_;
 };
 
+#if RAII_HAS_POSIX_IO
+// Returns the first '\n' in [begin, end) or end. Scans 16 bytes per step
+// with SSE2 when available.
+inline const char* findNewline(const char* begin, const char* end) noexcept {
+#if defined(__SSE2__)
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (end - begin >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline));
+        if (mask != 0) {
+            return begin + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        begin += 16;
+    }
+#endif
+    const void* hit = std::memchr(begin, '\n', static_cast<size_t>(end - begin));
+    return hit ? static_cast<const char*>(hit) : end;
+}
+
+// Read-only memory-mapped file. Lines are returned as string_views straight
+// into the mapping: no per-line allocation and no copy into a stream buffer.
+// Views stay valid for the lifetime of the reader.
+class MappedFileReader {
+public:
+    explicit MappedFileReader(const std::string& filename) {
+        fd_ = ::open(filename.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+        struct stat info {};
+        if (::fstat(fd_, &info) != 0) {
+            ::close(fd_);
+            throw std::runtime_error("Failed to stat file: " + filename);
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0) {
+            void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd_);
+                throw std::runtime_error("Failed to map file: " + filename);
+            }
+            // Hint the kernel to read ahead aggressively and drop pages behind us
+            ::madvise(mapping, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(mapping);
+        }
+        cursor_ = data_;
+    }
+    
+    ~MappedFileReader() {
+        release();
+    }
+    
+    MappedFileReader(MappedFileReader&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1))
+        , data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , cursor_(std::exchange(other.cursor_, nullptr)) {}
+    
+    MappedFileReader& operator=(MappedFileReader&& other) noexcept {
+        if (this != &other) {
+            release();
+            fd_ = std::exchange(other.fd_, -1);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            cursor_ = std::exchange(other.cursor_, nullptr);
+        }
+        return *this;
+    }
+    
+    MappedFileReader(const MappedFileReader&) = delete;
+    MappedFileReader& operator=(const MappedFileReader&) = delete;
+    
+    // Returns false at end of file. A trailing line without '\n' is still returned.
+    bool nextLine(std::string_view& line) noexcept {
+        const char* end = data_ + size_;
+        if (cursor_ == end) {
+            return false;
+        }
+        const char* newline = findNewline(cursor_, end);
+        line = std::string_view(cursor_, static_cast<size_t>(newline - cursor_));
+        cursor_ = newline == end ? end : newline + 1;
+        return true;
+    }
+    
+    template<typename Func>
+    size_t forEachLine(Func&& func) {
+        size_t count = 0;
+        std::string_view line;
+        while (nextLine(line)) {
+            func(line);
+            ++count;
+        }
+        return count;
+    }
+    
+    void rewind() noexcept {
+        cursor_ = data_;
+    }
+    
+    [[nodiscard]] std::string_view contents() const noexcept {
+        return {data_, size_};
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return size_;
+    }
+
+private:
+    void release() noexcept {
+        if (data_) {
+            ::munmap(const_cast<char*>(data_), size_);
+            data_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+    
+    int fd_ = -1;
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    const char* cursor_ = nullptr;
+};
+
+// Block-buffered writer. Lines accumulate in a large aligned buffer that is
+// written with a single write() when full or on an explicit flush(); nothing
+// is flushed per line.
+class BufferedFileWriter {
+public:
+    struct Options {
+        size_t blockSize = 1 << 20;  // multiple of 4096 when directIO is set
+        bool directIO = false;       // O_DIRECT: bypass the page cache (Linux)
+        bool syncOnFlush = false;    // fdatasync after every flush()
+    };
+    
+    explicit BufferedFileWriter(const std::string& filename)
+        : BufferedFileWriter(filename, Options{}) {}
+    
+    BufferedFileWriter(const std::string& filename, Options options)
+        : options_(options) {
+        if (options_.blockSize == 0 || options_.blockSize % kAlignment != 0) {
+            throw std::invalid_argument("Block size must be a positive multiple of 4096");
+        }
+        int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+        if (options_.directIO) {
+            flags |= O_DIRECT;
+        }
+#else
+        options_.directIO = false;
+#endif
+        fd_ = ::open(filename.c_str(), flags, 0644);
+        if (fd_ < 0) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+        void* buffer = nullptr;
+        if (::posix_memalign(&buffer, kAlignment, options_.blockSize) != 0) {
+            ::close(fd_);
+            throw std::bad_alloc();
+        }
+        buffer_ = static_cast<char*>(buffer);
+    }
+    
+    // Destructors must not throw: errors on the final flush are swallowed,
+    // call close() explicitly to observe them. The descriptor is released
+    // either way.
+    ~BufferedFileWriter() {
+        try {
+            close();
+        } catch (...) {
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        std::free(buffer_);
+    }
+    
+    BufferedFileWriter(const BufferedFileWriter&) = delete;
+    BufferedFileWriter& operator=(const BufferedFileWriter&) = delete;
+    
+    void write(std::string_view data) {
+        while (!data.empty()) {
+            if (used_ == options_.blockSize) {
+                flushBlocks();
+            }
+            size_t chunk = std::min(data.size(), options_.blockSize - used_);
+            std::memcpy(buffer_ + used_, data.data(), chunk);
+            used_ += chunk;
+            data.remove_prefix(chunk);
+        }
+    }
+    
+    void writeLine(std::string_view line) {
+        write(line);
+        write("\n");
+    }
+    
+    // Pushes buffered data to the OS. With O_DIRECT only whole aligned blocks
+    // can be written, so a partial tail stays buffered until close().
+    void flush() {
+        flushBlocks();
+        if (!options_.directIO && used_ > 0) {
+            writeAll(buffer_, used_);
+            used_ = 0;
+        }
+        if (options_.syncOnFlush) {
+            sync();
+        }
+    }
+    
+    void sync() {
+#if defined(__APPLE__)
+        if (::fsync(fd_) != 0) {
+#else
+        if (::fdatasync(fd_) != 0) {
+#endif
+            throw std::runtime_error("fdatasync failed");
+        }
+    }
+    
+    // Closes the descriptor even when the final flush throws
+    void close() {
+        if (fd_ < 0) {
+            return;
+        }
+        try {
+            flushBlocks();
+            if (used_ > 0) {
+#ifdef O_DIRECT
+                if (options_.directIO) {
+                    // The unaligned tail cannot go through O_DIRECT
+                    ::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) & ~O_DIRECT);
+                }
+#endif
+                writeAll(buffer_, used_);
+                used_ = 0;
+            }
+            if (options_.syncOnFlush) {
+                sync();
+            }
+        } catch (...) {
+            ::close(fd_);
+            fd_ = -1;
+            throw;
+        }
+        ::close(fd_);
+        fd_ = -1;
+    }
+    
+    [[nodiscard]] size_t bytesWritten() const noexcept {
+        return written_ + used_;
+    }
+
+private:
+    static constexpr size_t kAlignment = 4096;
+    
+    void flushBlocks() {
+        size_t whole = options_.directIO ? used_ - used_ % kAlignment : used_;
+        if (whole == 0) {
+            return;
+        }
+        writeAll(buffer_, whole);
+        std::memmove(buffer_, buffer_ + whole, used_ - whole);
+        used_ -= whole;
+    }
+    
+    void writeAll(const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t n = ::write(fd_, data, size);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error(std::string("write failed: ") + std::strerror(errno));
+            }
+            data += n;
+            size -= static_cast<size_t>(n);
+            written_ += static_cast<size_t>(n);
+        }
+    }
+    
+    Options options_;
+    int fd_ = -1;
+    char* buffer_ = nullptr;
+    size_t used_ = 0;
+    size_t written_ = 0;
+};
+#endif // RAII_HAS_POSIX_IO
+
 // Modern memory manager using RAII
 class ModernMemoryManager {
 public:
@@ -157,6 +516,12 @@ public:
         std::cout << "Allocated " << size << " integers using RAII" << std::endl;
     }
     
+    // Skips zero-filling for callers that overwrite every element anyway
+    // (e.g. fillData() right after construction).
+    [[nodiscard]] static ModernMemoryManager forOverwrite(size_t size) {
+        return ModernMemoryManager(std::unique_ptr<int[]>(new int[size]), size);
+    }
+    
     // Destructor automatically deallocates memory
     ~ModernMemoryManager() = default; // unique_ptr handles cleanup
     
@@ -200,206 +565,1732 @@ public:
     }
 
 private:
+    ModernMemoryManager(std::unique_ptr<int[]> data, size_t size)
+        : data_(std::move(data)), size_(size) {
+        std::cout << "Allocated " << size << " integers (default-initialized)" << std::endl;
+    }
+    
     std::unique_ptr<int[]> data_;
     size_t size_;
 };
 
-// RAII mutex wrapper
-class ScopedLock {
+#if RAII_HAS_POSIX_IO
+// Page-level backing options for large RAII allocations
+struct PageOptions {
+    bool hugePages = false;            // MAP_HUGETLB: explicit huge pages, falls back if unavailable
+    bool transparentHugePages = false; // madvise(MADV_HUGEPAGE)
+    int numaNode = -1;                 // preferred NUMA node, -1 = no preference
+};
+
+// RAII anonymous mapping. Pages are not touched (and not zero-filled by us);
+// the kernel supplies zero pages lazily on first write. A zero size gives an
+// empty region, like the default constructor.
+class MappedRegion {
 public:
-    explicit ScopedLock(std::mutex& mutex) : mutex_(mutex) {
-        mutex_.lock();
-        std::cout << "Mutex locked" << std::endl;
-    }
+    MappedRegion() = default;
     
-    ~ScopedLock() {
-        mutex_.unlock();
-        std::cout << "Mutex unlocked" << std::endl;
+    explicit MappedRegion(size_t size, PageOptions options = {}) : size_(size) {
+        if (options.numaNode >= kMaxNumaNodes) {
+            throw std::invalid_argument("NUMA node out of range");
+        }
+        if (size == 0) {
+            return;
+        }
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        void* mapping = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        if (options.hugePages) {
+            constexpr size_t hugePage = 2 * 1024 * 1024;
+            size_t rounded = (size + hugePage - 1) / hugePage * hugePage;
+            mapping = ::mmap(nullptr, rounded, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+            if (mapping != MAP_FAILED) {
+                size_ = rounded;
+                hugePages_ = true;
+            }
+        }
+#endif
+        if (mapping == MAP_FAILED) {
+            mapping = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, flags, -1, 0);
+            if (mapping == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+        }
+#ifdef MADV_HUGEPAGE
+        if (options.transparentHugePages && !hugePages_) {
+            ::madvise(mapping, size_, MADV_HUGEPAGE);
+        }
+#endif
+        if (options.numaNode >= 0) {
+            preferNode(mapping, size_, options.numaNode);
+        }
+        data_ = mapping;
     }
     
-    // Delete copy operations
-    ScopedLock(const ScopedLock&) = delete;
-    ScopedLock& operator=(const ScopedLock&) = delete;
-
-private:
-    std::mutex& mutex_;
-};
-
-// RAII timer for performance measurement
-class ScopedTimer {
-public:
-    ScopedTimer(const std::string& name) 
-        : name_(name), start_(std::chrono::high_resolution_clock::now()) {
-        std::cout << "Timer started: " << name_ << std::endl;
+    ~MappedRegion() {
+        if (data_) {
+            ::munmap(data_, size_);
+        }
     }
     
-    ~ScopedTimer() {
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start_);
-        std::cout << "Timer " << name_ << " took " << duration.count() << " microseconds" << std::endl;
+    MappedRegion(MappedRegion&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , hugePages_(other.hugePages_) {}
+    
+    MappedRegion& operator=(MappedRegion&& other) noexcept {
+        if (this != &other) {
+            if (data_) {
+                ::munmap(data_, size_);
+            }
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            hugePages_ = other.hugePages_;
+        }
+        return *this;
     }
     
-    // Delete copy operations
-    ScopedTimer(const ScopedTimer&) = delete;
-    ScopedTimer& operator=(const ScopedTimer&) = delete;
+    MappedRegion(const MappedRegion&) = delete;
+    MappedRegion& operator=(const MappedRegion&) = delete;
+    
+    [[nodiscard]] void* data() const noexcept { return data_; }
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool usesHugePages() const noexcept { return hugePages_; }
 
 private:
-    std::string name_;
-    std::chrono::high_resolution_clock::time_point start_;
+    // One bit per node in the single-word mask passed to mbind
+    static constexpr int kMaxNumaNodes = static_cast<int>(sizeof(unsigned long) * 8);
+    
+    // Placement hint only: failures (no NUMA, single node) are ignored
+    static void preferNode(void* addr, size_t size, int node) noexcept {
+#if defined(__linux__) && defined(SYS_mbind)
+        constexpr int kMpolPreferred = 1;
+        unsigned long nodeMask = 1UL << node;
+        ::syscall(SYS_mbind, addr, size, kMpolPreferred, &nodeMask, sizeof(nodeMask) * 8, 0);
+#else
+        (void)addr;
+        (void)size;
+        (void)node;
+#endif
+    }
+    
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    bool hugePages_ = false;
 };
 
-// RAII connection wrapper
-class DatabaseConnection {
+// Bump allocator over large mapped chunks. Allocation is a pointer bump,
+// memory is default-initialized (never zeroed by the arena), and everything
+// is released at once with reset() or a ScopedArenaReset.
+class MonotonicArena {
 public:
-    DatabaseConnection(const std::string& connectionString) 
-        : connectionString_(connectionString), connected_(false) {
-        connect();
-    }
+    struct Marker {
+        size_t chunk;
+        size_t offset;
+    };
     
-    ~DatabaseConnection() {
-        disconnect();
-    }
+    explicit MonotonicArena(size_t chunkSize = 4 * 1024 * 1024, PageOptions options = {})
+        : chunkSize_(chunkSize), options_(options) {}
     
-    // Move semantics
-    DatabaseConnection(DatabaseConnection&& other) noexcept
-        : connectionString_(std::move(other.connectionString_))
-        , connected_(other.connected_) {
-        other.connected_ = false;
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+    
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        if (size > std::numeric_limits<size_t>::max() - alignment) {
+            throw std::bad_alloc();
+        }
+        if (current_ < chunks_.size()) {
+            auto base = reinterpret_cast<uintptr_t>(chunks_[current_].data());
+            uintptr_t aligned = (base + offset_ + alignment - 1) & ~(uintptr_t(alignment) - 1);
+            if (aligned + size <= base + chunks_[current_].size()) {
+                offset_ = aligned + size - base;
+                return reinterpret_cast<void*>(aligned);
+            }
+        }
+        nextChunk(size + alignment);
+        return allocate(size, alignment);
     }
     
-    DatabaseConnection& operator=(DatabaseConnection&& other) noexcept {
-        if (this != &other) {
-            disconnect();
-            connectionString_ = std::move(other.connectionString_);
-            connected_ = other.connected_;
-            other.connected_ = false;
+    // Default-initialized array: no value-initialization pass
+    template<typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+        if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
         }
-        return *this;
+        return ::new (allocate(sizeof(T) * count, alignof(T))) T[count];
     }
     
-    // Delete copy operations
-    DatabaseConnection(const DatabaseConnection&) = delete;
-    DatabaseConnection& operator=(const DatabaseConnection&) = delete;
+    [[nodiscard]] Marker mark() const noexcept {
+        return {current_, offset_};
+    }
     
-    void executeQuery(const std::string& query) {
-        if (!connected_) {
-            throw std::runtime_error("Not connected to database");
-        }
-        std::cout << "Executing query: " << query << std::endl;
+    // Rewinds to a marker; chunks stay mapped for reuse
+    void release(Marker marker) noexcept {
+        current_ = marker.chunk;
+        offset_ = marker.offset;
     }
     
-    [[nodiscard]] bool isConnected() const noexcept {
-        return connected_;
+    void reset() noexcept {
+        release({0, 0});
+    }
+    
+    [[nodiscard]] size_t reservedBytes() const noexcept {
+        size_t total = 0;
+        for (const auto& chunk : chunks_) {
+            total += chunk.size();
+        }
+        return total;
     }
 
 private:
-    void connect() {
-        std::cout << "Connecting to database: " << connectionString_ << std::endl;
-        connected_ = true;
-    }
-    
-    void disconnect() {
-        if (connected_) {
-            std::cout << "Disconnecting from database: " << connectionString_ << std::endl;
-            connected_ = false;
+    void nextChunk(size_t minimum) {
+        // Reuse a chunk retained from before a reset when it is big enough
+        while (current_ + 1 < chunks_.size()) {
+            ++current_;
+            offset_ = 0;
+            if (chunks_[current_].size() >= minimum) {
+                return;
+            }
         }
+        chunks_.emplace_back(std::max(chunkSize_, minimum), options_);
+        current_ = chunks_.size() - 1;
+        offset_ = 0;
     }
+    
+    size_t chunkSize_;
+    PageOptions options_;
+    std::vector<MappedRegion> chunks_;
+    size_t current_ = 0;
+    size_t offset_ = 0;
+};
+
+// RAII scope: everything allocated from the arena inside the scope is
+// released when the scope ends
+class ScopedArenaReset {
+public:
+    explicit ScopedArenaReset(MonotonicArena& arena) : arena_(arena), marker_(arena.mark()) {}
+    ~ScopedArenaReset() { arena_.release(marker_); }
+    
+    ScopedArenaReset(const ScopedArenaReset&) = delete;
+    ScopedArenaReset& operator=(const ScopedArenaReset&) = delete;
 
 private:
-    std::string connectionString_;
-    bool connected_;
+    MonotonicArena& arena_;
+    MonotonicArena::Marker marker_;
 };
 
-// Modern resource manager using RAII
-class ResourceManager {
+// Size-class pool: power-of-two classes from 16 B to 4 KiB, each with an
+// intrusive free list carved from 64 KiB slabs taken from an arena. Larger
+// requests go to operator new. Not thread-safe: use one pool per thread.
+class SizeClassPool {
 public:
-    ResourceManager() = default;
+    static constexpr size_t kMinClass = 16;
+    static constexpr size_t kMaxClass = 4096;
+    static constexpr size_t kClassCount = 9;  // 16, 32, ..., 4096
+    static constexpr size_t kSlabSize = 64 * 1024;
     
-    // RAII-managed resources
-    void createFile(const std::string& filename) {
-        files_.emplace_back(filename);
-    }
+    explicit SizeClassPool(PageOptions options = {}) : arena_(4 * 1024 * 1024, options) {}
     
-    void createMemory(size_t size) {
-        memory_.emplace_back(size);
-    }
+    SizeClassPool(const SizeClassPool&) = delete;
+    SizeClassPool& operator=(const SizeClassPool&) = delete;
     
-    void createConnection(const std::string& connectionString) {
-        connections_.emplace_back(connectionString);
+    void* allocate(size_t size) {
+        if (size > kMaxClass) {
+            return ::operator new(size);
+        }
+        size_t index = classIndex(size);
+        FreeNode*& head = freeLists_[index];
+        if (!head) {
+            refill(index);
+        }
+        FreeNode* node = head;
+        head = node->next;
+        return node;
     }
     
-    // Process resources with exception safety
-    void processAll() {
-        {
-            ScopedTimer timer("File processing");
-            for (auto& file : files_) {
-                file.writeLine("Processing data");
-            }
-        }
-        
-        {
-            ScopedTimer timer("Memory processing");
-            for (auto& mem : memory_) {
-                mem.fillData();
-            }
+    void deallocate(void* pointer, size_t size) noexcept {
+        if (!pointer) {
+            return;
         }
-        
-        {
-            ScopedTimer timer("Database processing");
-            for (auto& conn : connections_) {
-                conn.executeQuery("SELECT * FROM data");
-            }
+        if (size > kMaxClass) {
+            ::operator delete(pointer);
+            return;
         }
+        auto* node = static_cast<FreeNode*>(pointer);
+        FreeNode*& head = freeLists_[classIndex(size)];
+        node->next = head;
+        head = node;
     }
     
-    // Exception-safe operations
-    void processWithExceptions() {
-        try {
-            for (auto& file : files_) {
-                file.processWithException();
-            }
-        } catch (const std::exception& e) {
-            std::cout << "Exception caught: " << e.what() << std::endl;
-            // All resources are automatically cleaned up
+    template<typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "Pool arrays must be trivially destructible");
+        if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
         }
+        return ::new (allocate(sizeof(T) * count)) T[count];
+    }
+    
+    template<typename T>
+    void deallocateArray(T* pointer, size_t count) noexcept {
+        deallocate(pointer, sizeof(T) * count);
     }
 
 private:
-    std::vector<ModernFileHandler> files_;
+    struct FreeNode {
+        FreeNode* next;
+    };
+    
+    // ceil(log2(size)) - log2(kMinClass), clamped at the smallest class
+    static size_t classIndex(size_t size) noexcept {
+        if (size <= kMinClass) {
+            return 0;
+        }
+        return static_cast<size_t>(64 - __builtin_clzll(size - 1)) - 4;
+    }
+    
+    void refill(size_t index) {
+        size_t classSize = kMinClass << index;
+        auto* slab = static_cast<char*>(arena_.allocate(kSlabSize, kMinClass));
+        FreeNode* head = nullptr;
+        for (size_t offset = kSlabSize; offset >= classSize; offset -= classSize) {
+            auto* node = reinterpret_cast<FreeNode*>(slab + offset - classSize);
+            node->next = head;
+            head = node;
+        }
+        freeLists_[index] = head;
+    }
+    
+    MonotonicArena arena_;
+    std::array<FreeNode*, kClassCount> freeLists_{};
+};
+
+// RAII handle for a pooled int buffer: returns its block to the pool
+class PooledIntBuffer {
+public:
+    PooledIntBuffer(SizeClassPool& pool, size_t size)
+        : pool_(&pool), data_(pool.allocateArray<int>(size)), size_(size) {}
+    
+    ~PooledIntBuffer() {
+        if (data_) {
+            pool_->deallocateArray(data_, size_);
+        }
+    }
+    
+    PooledIntBuffer(PooledIntBuffer&& other) noexcept
+        : pool_(other.pool_), data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+    
+    PooledIntBuffer& operator=(PooledIntBuffer&& other) noexcept {
+        if (this != &other) {
+            if (data_) {
+                pool_->deallocateArray(data_, size_);
+            }
+            pool_ = other.pool_;
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+    
+    PooledIntBuffer(const PooledIntBuffer&) = delete;
+    PooledIntBuffer& operator=(const PooledIntBuffer&) = delete;
+    
+    int& operator[](size_t index) noexcept { return data_[index]; }
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+private:
+    SizeClassPool* pool_;
+    int* data_;
+    size_t size_;
+};
+#endif // RAII_HAS_POSIX_IO
+
+// RAII mutex wrapper
+class ScopedLock {
+public:
+    explicit ScopedLock(std::mutex& mutex) : mutex_(mutex) {
+        mutex_.lock();
+        std::cout << "Mutex locked" << std::endl;
+    }
+    
+    ~ScopedLock() {
+        mutex_.unlock();
+        std::cout << "Mutex unlocked" << std::endl;
+    }
+    
+    // Delete copy operations
+    ScopedLock(const ScopedLock&) = delete;
+    ScopedLock& operator=(const ScopedLock&) = delete;
+
+private:
+    std::mutex& mutex_;
+};
+
+// Spin-wait hint for busy loops
+inline void cpuRelax() noexcept {
+#if defined(__SSE2__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Adaptive mutex: spins briefly (the common case is a short critical section
+// released within a few hundred cycles), then parks the thread in the kernel
+// instead of burning CPU. State: 0 = unlocked, 1 = locked, 2 = locked with
+// sleepers. Linux parks on a futex; other systems fall back to yielding.
+class AdaptiveMutex {
+public:
+    AdaptiveMutex() = default;
+    AdaptiveMutex(const AdaptiveMutex&) = delete;
+    AdaptiveMutex& operator=(const AdaptiveMutex&) = delete;
+    
+    void lock() noexcept {
+        for (int spin = 0; spin < kSpinLimit; ++spin) {
+            if (state_.load(std::memory_order_relaxed) == 0 && try_lock()) {
+                return;
+            }
+            cpuRelax();
+        }
+        int previous = state_.exchange(2, std::memory_order_acquire);
+        while (previous != 0) {
+            park();
+            previous = state_.exchange(2, std::memory_order_acquire);
+        }
+    }
+    
+    bool try_lock() noexcept {
+        int expected = 0;
+        return state_.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+    
+    void unlock() noexcept {
+        if (state_.exchange(0, std::memory_order_release) == 2) {
+            wakeOne();
+        }
+    }
+
+private:
+    static constexpr int kSpinLimit = 100;
+    
+    void park() noexcept {
+#if defined(__linux__)
+        ::syscall(SYS_futex, reinterpret_cast<int*>(&state_), FUTEX_WAIT_PRIVATE, 2, nullptr, nullptr, 0);
+#else
+        std::this_thread::yield();
+#endif
+    }
+    
+    void wakeOne() noexcept {
+#if defined(__linux__)
+        ::syscall(SYS_futex, reinterpret_cast<int*>(&state_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+    }
+    
+    std::atomic<int> state_{0};
+};
+
+// FIFO ticket lock: strict arrival-order fairness, no starvation. Spins, then
+// yields, so it suits short critical sections with few contenders.
+class TicketLock {
+public:
+    TicketLock() = default;
+    TicketLock(const TicketLock&) = delete;
+    TicketLock& operator=(const TicketLock&) = delete;
+    
+    void lock() noexcept {
+        const unsigned ticket = next_.fetch_add(1, std::memory_order_relaxed);
+        int spins = 0;
+        while (serving_.load(std::memory_order_acquire) != ticket) {
+            if (++spins < kSpinLimit) {
+                cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+    
+    bool try_lock() noexcept {
+        unsigned current = serving_.load(std::memory_order_acquire);
+        unsigned expected = current;
+        return next_.compare_exchange_strong(expected, current + 1, std::memory_order_acquire,
+                                             std::memory_order_relaxed);
+    }
+    
+    void unlock() noexcept {
+        serving_.store(serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    static constexpr int kSpinLimit = 100;
+    
+    alignas(64) std::atomic<unsigned> next_{0};
+    alignas(64) std::atomic<unsigned> serving_{0};
+};
+
+// Per-call-site contention statistics. Declare one LockSite per place a lock
+// is taken; sites register themselves for their lifetime and can be dumped
+// at any time.
+class LockSite {
+public:
+    static constexpr size_t kBuckets = 32;  // log2(ns) wait-time histogram
+    
+    explicit LockSite(const char* name) : name_(name) {
+        Registry& sites = registry();
+        std::lock_guard<std::mutex> lock(sites.mutex);
+        next_ = sites.head;
+        if (next_) {
+            next_->prev_ = this;
+        }
+        sites.head = this;
+    }
+    
+    // Unlinks under the registry lock so dumpAll never follows a dead site
+    ~LockSite() {
+        Registry& sites = registry();
+        std::lock_guard<std::mutex> lock(sites.mutex);
+        if (prev_) {
+            prev_->next_ = next_;
+        } else {
+            sites.head = next_;
+        }
+        if (next_) {
+            next_->prev_ = prev_;
+        }
+    }
+    
+    LockSite(const LockSite&) = delete;
+    LockSite& operator=(const LockSite&) = delete;
+    
+    void recordAcquire(uint64_t waitNs, bool contended) noexcept {
+        acquisitions_.fetch_add(1, std::memory_order_relaxed);
+        if (contended) {
+            contended_.fetch_add(1, std::memory_order_relaxed);
+            waitNs_.fetch_add(waitNs, std::memory_order_relaxed);
+            waitHistogram_[bucketOf(waitNs)].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    void recordHold(uint64_t holdNs) noexcept {
+        holdNs_.fetch_add(holdNs, std::memory_order_relaxed);
+        uint64_t previous = maxHoldNs_.load(std::memory_order_relaxed);
+        while (holdNs > previous &&
+               !maxHoldNs_.compare_exchange_weak(previous, holdNs, std::memory_order_relaxed)) {
+        }
+    }
+    
+    void report(std::ostream& out) const {
+        uint64_t acquisitions = acquisitions_.load(std::memory_order_relaxed);
+        uint64_t contended = contended_.load(std::memory_order_relaxed);
+        uint64_t waitNs = waitNs_.load(std::memory_order_relaxed);
+        uint64_t holdNs = holdNs_.load(std::memory_order_relaxed);
+        out << "[" << name_ << "] acquisitions=" << acquisitions
+            << " contended=" << contended
+            << " avgWait=" << (contended ? waitNs / contended : 0) << "ns"
+            << " avgHold=" << (acquisitions ? holdNs / acquisitions : 0) << "ns"
+            << " maxHold=" << maxHoldNs_.load(std::memory_order_relaxed) << "ns\n";
+        for (size_t i = 0; i < kBuckets; ++i) {
+            uint64_t count = waitHistogram_[i].load(std::memory_order_relaxed);
+            if (count > 0) {
+                out << "    wait < " << std::setw(12) << (uint64_t(1) << (i + 1)) << "ns: " << count << "\n";
+            }
+        }
+    }
+    
+    void reset() noexcept {
+        acquisitions_ = 0;
+        contended_ = 0;
+        waitNs_ = 0;
+        holdNs_ = 0;
+        maxHoldNs_ = 0;
+        for (auto& bucket : waitHistogram_) {
+            bucket = 0;
+        }
+    }
+    
+    // Dumps every registered site
+    static void dumpAll(std::ostream& out) {
+        Registry& sites = registry();
+        std::lock_guard<std::mutex> lock(sites.mutex);
+        for (const LockSite* site = sites.head; site; site = site->next_) {
+            site->report(out);
+        }
+    }
+
+private:
+    struct Registry {
+        std::mutex mutex;
+        LockSite* head = nullptr;
+    };
+    
+    // Constructed by the first site, so it outlives every static site
+    static Registry& registry() noexcept {
+        static Registry sites;
+        return sites;
+    }
+    
+    static size_t bucketOf(uint64_t ns) noexcept {
+        size_t bucket = ns == 0 ? 0 : static_cast<size_t>(63 - __builtin_clzll(ns));
+        return bucket < kBuckets ? bucket : kBuckets - 1;
+    }
+    
+    const char* name_;
+    LockSite* prev_ = nullptr;
+    LockSite* next_ = nullptr;
+    std::atomic<uint64_t> acquisitions_{0};
+    std::atomic<uint64_t> contended_{0};
+    std::atomic<uint64_t> waitNs_{0};
+    std::atomic<uint64_t> holdNs_{0};
+    std::atomic<uint64_t> maxHoldNs_{0};
+    std::array<std::atomic<uint64_t>, kBuckets> waitHistogram_{};
+};
+
+// RAII guard for any Lockable. With RAII_LOCK_PROFILING it records, per
+// site, acquisition counts, wait time (only when try_lock fails, so the
+// uncontended path stays a single extra clock read) and hold time.
+template<typename Mutex>
+class ProfiledLockGuard {
+public:
+#if RAII_LOCK_PROFILING
+    ProfiledLockGuard(Mutex& mutex, LockSite& site) : mutex_(mutex), site_(site) {
+        uint64_t waitNs = 0;
+        bool contended = !mutex_.try_lock();
+        if (contended) {
+            auto waitStart = Clock::now();
+            mutex_.lock();
+            acquired_ = Clock::now();
+            waitNs = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(acquired_ - waitStart).count());
+        } else {
+            acquired_ = Clock::now();
+        }
+        site_.recordAcquire(waitNs, contended);
+    }
+    
+    ~ProfiledLockGuard() {
+        auto holdNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - acquired_).count();
+        mutex_.unlock();
+        site_.recordHold(static_cast<uint64_t>(holdNs));
+    }
+#else
+    ProfiledLockGuard(Mutex& mutex, LockSite&) : mutex_(mutex) {
+        mutex_.lock();
+    }
+    
+    ~ProfiledLockGuard() {
+        mutex_.unlock();
+    }
+#endif
+    
+    ProfiledLockGuard(const ProfiledLockGuard&) = delete;
+    ProfiledLockGuard& operator=(const ProfiledLockGuard&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    Mutex& mutex_;
+#if RAII_LOCK_PROFILING
+    LockSite& site_;
+    Clock::time_point acquired_;
+#endif
+};
+
+// RAII timer for performance measurement
+class ScopedTimer {
+public:
+    ScopedTimer(const std::string& name) 
+        : name_(name), start_(std::chrono::high_resolution_clock::now()) {
+        std::cout << "Timer started: " << name_ << std::endl;
+    }
+    
+    ~ScopedTimer() {
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start_);
+        std::cout << "Timer " << name_ << " took " << duration.count() << " microseconds" << std::endl;
+    }
+    
+    // Delete copy operations
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    std::string name_;
+    std::chrono::high_resolution_clock::time_point start_;
+};
+
+// Low-overhead hierarchical tracing
+// ScopedTimer above is fine for a demo, but a steady_clock read plus a
+// formatted stdout line per scope is far too slow to leave in production.
+// The tracing subsystem below records fixed-size events into per-thread ring
+// buffers and leaves formatting to an explicit export step.
+
+// Cycle-counter clock: raw TSC ticks on x86, calibrated once against
+// steady_clock; other architectures fall back to steady_clock nanoseconds.
+class TraceClock {
+public:
+    static uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+    
+    static double nanosPerTick() {
+        static const double ratio = calibrate();
+        return ratio;
+    }
+
+private:
+    static double calibrate() {
+#if defined(__x86_64__) || defined(__i386__)
+        auto wallStart = std::chrono::steady_clock::now();
+        uint64_t tickStart = __rdtsc();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        uint64_t tickEnd = __rdtsc();
+        auto wallEnd = std::chrono::steady_clock::now();
+        double nanos = std::chrono::duration<double, std::nano>(wallEnd - wallStart).count();
+        return nanos / static_cast<double>(tickEnd - tickStart);
+#else
+        return 1.0;
+#endif
+    }
+};
+
+struct TraceRecord {
+    uint64_t start;
+    uint64_t end;
+    uint32_t nameId;
+    uint32_t sequence;        // per-thread scope number, starts at 1
+    uint32_t parentSequence;  // 0 for top-level scopes
+};
+
+// Single-writer ring buffer owned by one thread; keeps the newest records
+class ThreadTraceBuffer {
+public:
+    static constexpr size_t kCapacity = 1 << 16;
+    
+    explicit ThreadTraceBuffer(uint32_t threadIndex)
+        : records_(std::make_unique<TraceRecord[]>(kCapacity)), threadIndex_(threadIndex) {}
+    
+    void push(const TraceRecord& record) noexcept {
+        uint64_t written = written_.load(std::memory_order_relaxed);
+        records_[written & (kCapacity - 1)] = record;
+        written_.store(written + 1, std::memory_order_release);
+    }
+    
+    // Copies the retained records, oldest first. Records being overwritten
+    // concurrently may be torn; snapshot quiescent threads for exact output.
+    [[nodiscard]] std::vector<TraceRecord> snapshot() const {
+        uint64_t written = written_.load(std::memory_order_acquire);
+        uint64_t first = written > kCapacity ? written - kCapacity : 0;
+        std::vector<TraceRecord> result;
+        result.reserve(static_cast<size_t>(written - first));
+        for (uint64_t i = first; i < written; ++i) {
+            result.push_back(records_[i & (kCapacity - 1)]);
+        }
+        return result;
+    }
+    
+    void clear() noexcept {
+        written_.store(0, std::memory_order_release);
+    }
+    
+    // Hands a recycled buffer to a new thread
+    void reset(uint32_t threadIndex) noexcept {
+        clear();
+        openScope = 0;
+        nextSequence = 1;
+        threadIndex_ = threadIndex;
+    }
+    
+    [[nodiscard]] uint32_t threadIndex() const noexcept {
+        return threadIndex_;
+    }
+    
+    uint32_t openScope = 0;     // sequence of the innermost open scope
+    uint32_t nextSequence = 1;
+
+private:
+    std::unique_ptr<TraceRecord[]> records_;
+    std::atomic<uint64_t> written_{0};
+    uint32_t threadIndex_;
+};
+
+// Process-wide registry of scope names and thread buffers, plus export
+class Tracer {
+public:
+    struct ScopeStats {
+        std::string name;
+        uint64_t count = 0;
+        double totalNs = 0;
+        double minNs = 0;
+        double maxNs = 0;
+    };
+    
+    static Tracer& instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+    
+    // Called once per trace site (cached in a function-local static)
+    uint32_t intern(const char* name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto [it, inserted] = nameIds_.emplace(name, static_cast<uint32_t>(names_.size()));
+        if (inserted) {
+            names_.emplace_back(name);
+        }
+        return it->second;
+    }
+    
+    // Buffers are owned by the registry, so an exited thread's records stay
+    // exportable until a new thread recycles the buffer; the raw pointer keeps
+    // the hot path free of the lease's init guard
+    static ThreadTraceBuffer& localBuffer() {
+        static thread_local ThreadTraceBuffer* cached = nullptr;
+        if (!cached) {
+            static thread_local BufferLease lease(instance());
+            cached = lease.buffer;
+        }
+        return *cached;
+    }
+    
+    // Chrome trace-event JSON (load in chrome://tracing or Perfetto)
+    void writeChromeTrace(std::ostream& out) const {
+        const double nsPerTick = TraceClock::nanosPerTick();
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t origin = UINT64_MAX;
+        std::vector<std::pair<uint32_t, std::vector<TraceRecord>>> perThread;
+        for (const auto& buffer : buffers_) {
+            perThread.emplace_back(buffer->threadIndex(), buffer->snapshot());
+            for (const auto& record : perThread.back().second) {
+                origin = std::min(origin, record.start);
+            }
+        }
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        for (const auto& [thread, records] : perThread) {
+            for (const auto& record : records) {
+                out << (first ? "\n" : ",\n") << "{\"name\":";
+                writeJsonString(out, names_[record.nameId]);
+                out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread << std::fixed << std::setprecision(3)
+                    << ",\"ts\":" << static_cast<double>(record.start - origin) * nsPerTick / 1000.0
+                    << ",\"dur\":" << static_cast<double>(record.end - record.start) * nsPerTick / 1000.0
+                    << ",\"args\":{\"seq\":" << record.sequence << ",\"parent\":" << record.parentSequence << "}}";
+                first = false;
+            }
+        }
+        out << "\n]}\n";
+        out.unsetf(std::ios::floatfield);
+    }
+    
+    [[nodiscard]] std::vector<ScopeStats> aggregate() const {
+        const double nsPerTick = TraceClock::nanosPerTick();
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<ScopeStats> stats(names_.size());
+        for (size_t i = 0; i < names_.size(); ++i) {
+            stats[i].name = names_[i];
+        }
+        for (const auto& buffer : buffers_) {
+            for (const auto& record : buffer->snapshot()) {
+                double ns = static_cast<double>(record.end - record.start) * nsPerTick;
+                ScopeStats& entry = stats[record.nameId];
+                entry.minNs = entry.count == 0 ? ns : std::min(entry.minNs, ns);
+                entry.maxNs = std::max(entry.maxNs, ns);
+                entry.totalNs += ns;
+                ++entry.count;
+            }
+        }
+        stats.erase(std::remove_if(stats.begin(), stats.end(),
+                                   [](const ScopeStats& entry) { return entry.count == 0; }),
+                    stats.end());
+        return stats;
+    }
+    
+    void printSummary(std::ostream& out) const {
+        for (const auto& entry : aggregate()) {
+            out << std::left << std::setw(28) << entry.name << std::right
+                << " count=" << entry.count
+                << " mean=" << entry.totalNs / static_cast<double>(entry.count) << "ns"
+                << " min=" << entry.minNs << "ns"
+                << " max=" << entry.maxNs << "ns" << std::endl;
+        }
+    }
+    
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& buffer : buffers_) {
+            buffer->clear();
+        }
+    }
+
+private:
+    // Returns the thread's buffer to the free list when the thread exits
+    struct BufferLease {
+        explicit BufferLease(Tracer& tracer) : tracer(tracer), buffer(tracer.acquireBuffer()) {}
+        ~BufferLease() { tracer.releaseBuffer(buffer); }
+        
+        BufferLease(const BufferLease&) = delete;
+        BufferLease& operator=(const BufferLease&) = delete;
+        
+        Tracer& tracer;
+        ThreadTraceBuffer* buffer;
+    };
+    
+    Tracer() {
+        TraceClock::nanosPerTick();  // calibrate at startup, not mid-trace
+    }
+    
+    // Memory is bounded by the peak number of live traced threads
+    ThreadTraceBuffer* acquireBuffer() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t threadIndex = nextThreadIndex_++;
+        if (!freeBuffers_.empty()) {
+            ThreadTraceBuffer* buffer = freeBuffers_.back();
+            freeBuffers_.pop_back();
+            buffer->reset(threadIndex);
+            return buffer;
+        }
+        buffers_.push_back(std::make_unique<ThreadTraceBuffer>(threadIndex));
+        return buffers_.back().get();
+    }
+    
+    void releaseBuffer(ThreadTraceBuffer* buffer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        freeBuffers_.push_back(buffer);
+    }
+    
+    static void writeJsonString(std::ostream& out, const std::string& text) {
+        static const char hex[] = "0123456789abcdef";
+        out << '"';
+        for (char c : text) {
+            switch (c) {
+                case '"': out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\r': out << "\\r"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        out << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+                    } else {
+                        out << c;
+                    }
+            }
+        }
+        out << '"';
+    }
+    
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, uint32_t> nameIds_;
+    std::vector<std::string> names_;
+    std::vector<std::unique_ptr<ThreadTraceBuffer>> buffers_;
+    std::vector<ThreadTraceBuffer*> freeBuffers_;
+    uint32_t nextThreadIndex_ = 0;
+};
+
+// RAII trace scope: two clock reads and one record store, no formatting
+class TraceScope {
+public:
+    explicit TraceScope(uint32_t nameId)
+        : buffer_(Tracer::localBuffer()), nameId_(nameId) {
+        sequence_ = buffer_.nextSequence++;
+        parent_ = buffer_.openScope;
+        buffer_.openScope = sequence_;
+        start_ = TraceClock::now();
+    }
+    
+    ~TraceScope() {
+        uint64_t end = TraceClock::now();
+        buffer_.openScope = parent_;
+        buffer_.push({start_, end, nameId_, sequence_, parent_});
+    }
+    
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    ThreadTraceBuffer& buffer_;
+    uint32_t nameId_;
+    uint32_t sequence_;
+    uint32_t parent_;
+    uint64_t start_;
+};
+
+#define RAII_TRACE_CONCAT_IMPL(a, b) a##b
+#define RAII_TRACE_CONCAT(a, b) RAII_TRACE_CONCAT_IMPL(a, b)
+#if RAII_TRACING
+#define RAII_TRACE_SCOPE(name)                                                              \
+    static const uint32_t RAII_TRACE_CONCAT(traceId_, __LINE__) = Tracer::instance().intern(name); \
+    TraceScope RAII_TRACE_CONCAT(traceScope_, __LINE__)(RAII_TRACE_CONCAT(traceId_, __LINE__))
+#else
+#define RAII_TRACE_SCOPE(name) ((void)0)
+#endif
+
+// RAII connection wrapper
+class DatabaseConnection {
+public:
+    DatabaseConnection(const std::string& connectionString) 
+        : connectionString_(connectionString), connected_(false) {
+        connect();
+    }
+    
+    ~DatabaseConnection() {
+        disconnect();
+    }
+    
+    // Move semantics
+    DatabaseConnection(DatabaseConnection&& other) noexcept
+        : connectionString_(std::move(other.connectionString_))
+        , connected_(other.connected_) {
+        other.connected_ = false;
+    }
+    
+    DatabaseConnection& operator=(DatabaseConnection&& other) noexcept {
+        if (this != &other) {
+            disconnect();
+            connectionString_ = std::move(other.connectionString_);
+            connected_ = other.connected_;
+            other.connected_ = false;
+        }
+        return *this;
+    }
+    
+    // Delete copy operations
+    DatabaseConnection(const DatabaseConnection&) = delete;
+    DatabaseConnection& operator=(const DatabaseConnection&) = delete;
+    
+    void executeQuery(const std::string& query) {
+        if (!connected_) {
+            throw std::runtime_error("Not connected to database");
+        }
+        std::cout << "Executing query: " << query << std::endl;
+    }
+    
+    [[nodiscard]] bool isConnected() const noexcept {
+        return connected_;
+    }
+
+private:
+    void connect() {
+        std::cout << "Connecting to database: " << connectionString_ << std::endl;
+        connected_ = true;
+    }
+    
+    void disconnect() {
+        if (connected_) {
+            std::cout << "Disconnecting from database: " << connectionString_ << std::endl;
+            connected_ = false;
+        }
+    }
+
+private:
+    std::string connectionString_;
+    bool connected_;
+};
+
+// Stand-in for a real driver connection: connecting costs a configurable
+// latency (TCP + TLS + auth handshake), queries are cheap.
+class SimulatedConnection {
+public:
+    SimulatedConnection(std::string connectionString, std::chrono::microseconds connectLatency)
+        : connectionString_(std::move(connectionString)) {
+        std::this_thread::sleep_for(connectLatency);
+        liveConnections().fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    ~SimulatedConnection() {
+        liveConnections().fetch_sub(1, std::memory_order_relaxed);
+    }
+    
+    SimulatedConnection(const SimulatedConnection&) = delete;
+    SimulatedConnection& operator=(const SimulatedConnection&) = delete;
+    
+    size_t executeQuery(std::string_view query) {
+        ++queries_;
+        return query.size();
+    }
+    
+    [[nodiscard]] size_t queryCount() const noexcept {
+        return queries_;
+    }
+    
+    static std::atomic<int>& liveConnections() {
+        static std::atomic<int> live{0};
+        return live;
+    }
+
+private:
+    std::string connectionString_;
+    size_t queries_ = 0;
+};
+
+// RAII connection pool. lease() hands out a move-only guard that returns the
+// connection when it goes out of scope, so a connection can never leak, even
+// when the code using it throws. The pool must outlive its leases.
+template<typename Connection>
+class ConnectionPool {
+public:
+    using Factory = std::function<std::unique_ptr<Connection>()>;
+    using Clock = std::chrono::steady_clock;
+    
+    struct Options {
+        size_t minSize = 2;                                   // kept open and warmed up at startup
+        size_t maxSize = 8;                                   // hard cap on open connections
+        std::chrono::milliseconds idleTimeout{30000};         // idle longer than this is reaped
+        std::chrono::milliseconds acquireTimeout{5000};       // lease() gives up after this
+    };
+    
+    struct Metrics {
+        size_t leases = 0;         // successful lease() calls
+        size_t created = 0;
+        size_t reaped = 0;
+        size_t waits = 0;          // leases that found the pool exhausted
+        double totalWaitMs = 0;
+        double maxWaitMs = 0;
+        size_t peakInUse = 0;
+    };
+    
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept
+            : pool_(std::exchange(other.pool_, nullptr)), connection_(std::move(other.connection_)) {}
+        
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                release();
+                pool_ = std::exchange(other.pool_, nullptr);
+                connection_ = std::move(other.connection_);
+            }
+            return *this;
+        }
+        
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        
+        ~Lease() {
+            release();
+        }
+        
+        Connection* operator->() const noexcept { return connection_.get(); }
+        Connection& operator*() const noexcept { return *connection_; }
+        
+        // Drops a broken connection instead of returning it to the pool
+        void discard() {
+            if (pool_) {
+                pool_->discard(std::move(connection_));
+                pool_ = nullptr;
+            }
+        }
+        
+    private:
+        friend class ConnectionPool;
+        
+        Lease(ConnectionPool* pool, std::unique_ptr<Connection> connection)
+            : pool_(pool), connection_(std::move(connection)) {}
+        
+        void release() noexcept {
+            if (pool_) {
+                pool_->giveBack(std::move(connection_));
+                pool_ = nullptr;
+            }
+        }
+        
+        ConnectionPool* pool_;
+        std::unique_ptr<Connection> connection_;
+    };
+    
+    ConnectionPool(Factory factory, Options options)
+        : factory_(std::move(factory)), options_(options) {
+        if (options_.maxSize == 0 || options_.minSize > options_.maxSize) {
+            throw std::invalid_argument("ConnectionPool requires 0 <= minSize <= maxSize, maxSize > 0");
+        }
+        // idle_ never holds more than maxSize entries, so giveBack() cannot
+        // reallocate (and throw) later
+        idle_.reserve(options_.maxSize);
+        warmUp();
+    }
+    
+    ~ConnectionPool() {
+        stopReaper();
+    }
+    
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+    
+    Lease lease() {
+        auto waitStart = Clock::now();
+        std::unique_lock lock(mutex_);
+        bool waited = false;
+        while (idle_.empty() && open_ >= options_.maxSize) {
+            waited = true;
+            if (!available_.wait_until(lock, waitStart + options_.acquireTimeout,
+                                       [this] { return !idle_.empty() || open_ < options_.maxSize; })) {
+                throw std::runtime_error("Timed out waiting for a pooled connection");
+            }
+        }
+        if (waited) {
+            double waitMs = std::chrono::duration<double, std::milli>(Clock::now() - waitStart).count();
+            ++metrics_.waits;
+            metrics_.totalWaitMs += waitMs;
+            metrics_.maxWaitMs = std::max(metrics_.maxWaitMs, waitMs);
+        }
+        ++inUse_;
+        metrics_.peakInUse = std::max(metrics_.peakInUse, inUse_);
+        if (!idle_.empty()) {
+            ++metrics_.leases;
+            // LIFO: the most recently used connection is the warmest
+            auto connection = std::move(idle_.back().connection);
+            idle_.pop_back();
+            return Lease(this, std::move(connection));
+        }
+        // Reserve the slot, then connect without holding the lock
+        ++open_;
+        lock.unlock();
+        try {
+            auto connection = factory_();
+            std::lock_guard relock(mutex_);
+            ++metrics_.created;
+            ++metrics_.leases;
+            return Lease(this, std::move(connection));
+        } catch (...) {
+            std::lock_guard relock(mutex_);
+            --open_;
+            --inUse_;
+            available_.notify_one();
+            throw;
+        }
+    }
+    
+    // Opens connections until minSize are available
+    void warmUp() {
+        std::vector<std::unique_ptr<Connection>> fresh;
+        {
+            std::lock_guard lock(mutex_);
+            while (open_ + fresh.size() < options_.minSize) {
+                fresh.push_back(nullptr);
+            }
+            open_ += fresh.size();
+        }
+        size_t made = 0;
+        try {
+            for (; made < fresh.size(); ++made) {
+                fresh[made] = factory_();
+            }
+        } catch (...) {
+            // Keep what was created and hand back the slots that were not
+            addIdle(fresh, made);
+            throw;
+        }
+        addIdle(fresh, made);
+    }
+    
+    // Closes connections idle past idleTimeout, never dropping below minSize.
+    // Connections are destroyed outside the lock.
+    size_t reapIdle() {
+        std::vector<std::unique_ptr<Connection>> expired;
+        {
+            std::lock_guard lock(mutex_);
+            auto deadline = Clock::now() - options_.idleTimeout;
+            // idle_ is LIFO, so the oldest entries are at the front
+            size_t removable = 0;
+            while (removable < idle_.size() && open_ - removable > options_.minSize &&
+                   idle_[removable].since < deadline) {
+                ++removable;
+            }
+            for (size_t i = 0; i < removable; ++i) {
+                expired.push_back(std::move(idle_[i].connection));
+            }
+            idle_.erase(idle_.begin(), idle_.begin() + static_cast<std::ptrdiff_t>(removable));
+            open_ -= removable;
+            metrics_.reaped += removable;
+        }
+        return expired.size();
+    }
+    
+    void startReaper(std::chrono::milliseconds interval) {
+        stopReaper();
+        stopReaper_ = false;
+        reaper_ = std::thread([this, interval] {
+            std::unique_lock lock(reaperMutex_);
+            while (!reaperWake_.wait_for(lock, interval, [this] { return stopReaper_; })) {
+                lock.unlock();
+                reapIdle();
+                lock.lock();
+            }
+        });
+    }
+    
+    void stopReaper() {
+        {
+            std::lock_guard lock(reaperMutex_);
+            stopReaper_ = true;
+        }
+        reaperWake_.notify_all();
+        if (reaper_.joinable()) {
+            reaper_.join();
+        }
+    }
+    
+    [[nodiscard]] Metrics metrics() const {
+        std::lock_guard lock(mutex_);
+        return metrics_;
+    }
+    
+    [[nodiscard]] size_t openConnections() const {
+        std::lock_guard lock(mutex_);
+        return open_;
+    }
+    
+    [[nodiscard]] size_t idleConnections() const {
+        std::lock_guard lock(mutex_);
+        return idle_.size();
+    }
+
+private:
+    struct IdleEntry {
+        std::unique_ptr<Connection> connection;
+        Clock::time_point since;
+    };
+    
+    // Adds fresh[0, made) to the idle list and releases the remaining
+    // reserved slots
+    void addIdle(std::vector<std::unique_ptr<Connection>>& fresh, size_t made) {
+        {
+            std::lock_guard lock(mutex_);
+            for (size_t i = 0; i < made; ++i) {
+                idle_.push_back({std::move(fresh[i]), Clock::now()});
+                ++metrics_.created;
+            }
+            open_ -= fresh.size() - made;
+        }
+        available_.notify_all();
+    }
+    
+    void giveBack(std::unique_ptr<Connection> connection) noexcept {
+        {
+            std::lock_guard lock(mutex_);
+            --inUse_;
+            idle_.push_back({std::move(connection), Clock::now()});
+        }
+        available_.notify_one();
+    }
+    
+    void discard(std::unique_ptr<Connection> connection) {
+        {
+            std::lock_guard lock(mutex_);
+            --inUse_;
+            --open_;
+        }
+        connection.reset();
+        available_.notify_one();
+    }
+    
+    Factory factory_;
+    Options options_;
+    
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::vector<IdleEntry> idle_;
+    size_t open_ = 0;
+    size_t inUse_ = 0;
+    Metrics metrics_;
+    
+    std::thread reaper_;
+    std::mutex reaperMutex_;
+    std::condition_variable reaperWake_;
+    bool stopReaper_ = true;
+};
+
+// Fixed-size thread pool. The destructor drains the queue and joins all
+// workers, so no task can outlive the pool.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = std::max(2u, std::thread::hardware_concurrency())) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this] { workerLoop(); });
+        }
+    }
+    
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.push(std::move(task));
+        }
+        wake_.notify_one();
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return workers_.size();
+    }
+
+private:
+    void workerLoop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+    
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+};
+
+// RAII fork/join scope over a ThreadPool. wait() blocks until every task has
+// finished and rethrows the first exception any of them threw. The destructor
+// also waits, so tasks referencing stack objects can never outlive them, even
+// when the scope is left by an exception.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool) : pool_(pool) {}
+    
+    ~TaskGroup() {
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+    }
+    
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    
+    template<typename Func>
+    void run(Func func) {
+        {
+            std::lock_guard lock(mutex_);
+            ++pending_;
+        }
+        auto task = [this, func = std::move(func)]() mutable {
+            std::exception_ptr error;
+            try {
+                func();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::lock_guard lock(mutex_);
+            if (error && !firstError_) {
+                firstError_ = error;
+            }
+            if (--pending_ == 0) {
+                done_.notify_all();
+            }
+        };
+        try {
+            pool_.submit(std::move(task));
+        } catch (...) {
+            std::lock_guard lock(mutex_);
+            --pending_;
+            throw;
+        }
+    }
+    
+    void wait() {
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+        if (firstError_) {
+            std::rethrow_exception(std::exchange(firstError_, nullptr));
+        }
+    }
+
+private:
+    ThreadPool& pool_;
+    std::mutex mutex_;
+    std::condition_variable done_;
+    size_t pending_ = 0;
+    std::exception_ptr firstError_;
+};
+
+// Wall time vs. summed busy time for one processing phase. busy / wall is
+// the phase's effective parallelism.
+struct PhaseReport {
+    std::string name;
+    size_t items = 0;
+    double wallMs = 0;
+    double busyMs = 0;
+};
+
+// Modern resource manager using RAII
+class ResourceManager {
+public:
+    ResourceManager() = default;
+    
+    // RAII-managed resources
+    void createFile(const std::string& filename) {
+        files_.emplace_back(filename);
+    }
+    
+    // processAll() overwrites every element, so skip the zero-fill
+    void createMemory(size_t size) {
+        memory_.push_back(ModernMemoryManager::forOverwrite(size));
+    }
+    
+    void createConnection(const std::string& connectionString) {
+        connections_.emplace_back(connectionString);
+    }
+    
+    // Process resources with exception safety
+    void processAll() {
+        RAII_TRACE_SCOPE("ResourceManager::processAll");
+        {
+            ScopedTimer timer("File processing");
+            for (auto& file : files_) {
+                file.writeLine("Processing data");
+            }
+        }
+        
+        {
+            ScopedTimer timer("Memory processing");
+            for (auto& mem : memory_) {
+                mem.fillData();
+            }
+        }
+        
+        {
+            ScopedTimer timer("Database processing");
+            for (auto& conn : connections_) {
+                conn.executeQuery("SELECT * FROM data");
+            }
+        }
+    }
+    
+    // Parallel mode: every item of every phase becomes a pool task, so the
+    // phases overlap (I/O-bound file writes run next to CPU-bound fillData)
+    // as well as fanning out internally. Blocks until all items finish; the
+    // first exception thrown by any item is rethrown after the rest complete.
+    std::vector<PhaseReport> processAllParallel(ThreadPool& pool) {
+        RAII_TRACE_SCOPE("ResourceManager::processAllParallel");
+        using Clock = std::chrono::steady_clock;
+        
+        struct PhaseClock {
+            std::atomic<int64_t> busyNs{0};
+            std::atomic<int64_t> firstStartNs{INT64_MAX};
+            std::atomic<int64_t> lastEndNs{0};
+        };
+        std::array<PhaseClock, 3> clocks;
+        const auto origin = Clock::now();
+        
+        auto timed = [&origin](PhaseClock& clock, auto&& work) {
+            auto start = Clock::now();
+            work();
+            auto end = Clock::now();
+            auto startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(start - origin).count();
+            auto endNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - origin).count();
+            clock.busyNs.fetch_add(endNs - startNs, std::memory_order_relaxed);
+            int64_t first = clock.firstStartNs.load(std::memory_order_relaxed);
+            while (startNs < first && !clock.firstStartNs.compare_exchange_weak(first, startNs)) {
+            }
+            int64_t last = clock.lastEndNs.load(std::memory_order_relaxed);
+            while (endNs > last && !clock.lastEndNs.compare_exchange_weak(last, endNs)) {
+            }
+        };
+        
+        {
+            TaskGroup group(pool);
+            // Interleave submission so no phase waits behind another's backlog
+            size_t longest = std::max({files_.size(), memory_.size(), connections_.size()});
+            for (size_t i = 0; i < longest; ++i) {
+                if (i < files_.size()) {
+                    group.run([&, i] { timed(clocks[0], [&] { files_[i].writeLine("Processing data"); }); });
+                }
+                if (i < memory_.size()) {
+                    group.run([&, i] { timed(clocks[1], [&] { memory_[i].fillData(); }); });
+                }
+                if (i < connections_.size()) {
+                    group.run([&, i] { timed(clocks[2], [&] { connections_[i].executeQuery("SELECT * FROM data"); }); });
+                }
+            }
+            group.wait();
+        }
+        
+        const std::array<std::pair<const char*, size_t>, 3> phases{{
+            {"File processing", files_.size()},
+            {"Memory processing", memory_.size()},
+            {"Database processing", connections_.size()},
+        }};
+        std::vector<PhaseReport> reports;
+        for (size_t p = 0; p < phases.size(); ++p) {
+            PhaseReport report;
+            report.name = phases[p].first;
+            report.items = phases[p].second;
+            if (report.items > 0) {
+                report.wallMs = static_cast<double>(clocks[p].lastEndNs - clocks[p].firstStartNs) / 1e6;
+                report.busyMs = static_cast<double>(clocks[p].busyNs) / 1e6;
+            }
+            reports.push_back(report);
+        }
+        return reports;
+    }
+    
+    // Exception-safe operations
+    void processWithExceptions() {
+        try {
+            for (auto& file : files_) {
+                file.processWithException();
+            }
+        } catch (const std::exception& e) {
+            std::cout << "Exception caught: " << e.what() << std::endl;
+            // All resources are automatically cleaned up
+        }
+    }
+
+private:
+    std::vector<ModernFileHandler> files_;
     std::vector<ModernMemoryManager> memory_;
     std::vector<DatabaseConnection> connections_;
 };
 
 // Thread-safe resource manager using RAII
+// Names are looked up as string_view; the backing map is chosen at
+// construction (std::map by default, flat maps for hot tables)
 class ThreadSafeResourceManager {
 public:
-    void addResource(const std::string& name, const std::string& data) {
-        ScopedLock lock(mutex_);
-        resources_[name] = data;
+    explicit ThreadSafeResourceManager(StringMapKind kind = StringMapKind::Tree) : resources_(kind) {}
+    
+    void addResource(std::string_view name, std::string data) {
+        {
+            ScopedLock lock(mutex_);
+            resources_.insertOrAssign(name, std::move(data));
+        }
+        // Report outside the critical section
         std::cout << "Added resource: " << name << std::endl;
     }
     
-    std::string getResource(const std::string& name) {
+    std::string getResource(std::string_view name) {
         ScopedLock lock(mutex_);
-        auto it = resources_.find(name);
-        if (it != resources_.end()) {
-            return it->second;
-        }
-        return "";
+        const std::string* data = resources_.find(name);
+        return data ? *data : "";
     }
     
-    void removeResource(const std::string& name) {
-        ScopedLock lock(mutex_);
-        if (resources_.erase(name) > 0) {
+    void removeResource(std::string_view name) {
+        bool removed = false;
+        {
+            ScopedLock lock(mutex_);
+            removed = resources_.erase(name);
+        }
+        if (removed) {
             std::cout << "Removed resource: " << name << std::endl;
         }
     }
 
 private:
-    std::map<std::string, std::string> resources_;
+    StringMap<std::string> resources_;
     mutable std::mutex mutex_;
 };
 
+// Concurrent resource store: keys are spread over independent shards, each
+// guarded by its own shared_mutex, so readers never block each other and
+// writers only block one shard. Lookups take string_view keys (no temporary
+// std::string) and hand back shared immutable values instead of copies.
+class ShardedResourceStore {
+public:
+    using Value = std::shared_ptr<const std::string>;
+    
+    explicit ShardedResourceStore(size_t shardCount = 16) {
+        shardBits_ = 0;
+        while ((size_t(1) << shardBits_) < shardCount) {
+            ++shardBits_;
+        }
+        shards_ = std::make_unique<Shard[]>(size_t(1) << shardBits_);
+    }
+    
+    void put(std::string_view name, std::string data) {
+        uint64_t hash = hashOf(name);
+        auto value = std::make_shared<const std::string>(std::move(data));  // built outside the lock
+        Shard& shard = shardFor(hash);
+        std::unique_lock lock(shard.mutex);
+        shard.table.insertOrAssign(name, hash, std::move(value));
+    }
+    
+    [[nodiscard]] Value get(std::string_view name) const {
+        uint64_t hash = hashOf(name);
+        const Shard& shard = shardFor(hash);
+        std::shared_lock lock(shard.mutex);
+        const Value* value = shard.table.find(name, hash);
+        return value ? *value : Value{};
+    }
+    
+    // Zero-copy visit under the shard's read lock; keep the callback short
+    template<typename Func>
+    bool read(std::string_view name, Func&& func) const {
+        uint64_t hash = hashOf(name);
+        const Shard& shard = shardFor(hash);
+        std::shared_lock lock(shard.mutex);
+        const Value* value = shard.table.find(name, hash);
+        if (!value) {
+            return false;
+        }
+        func(std::string_view(**value));
+        return true;
+    }
+    
+    bool remove(std::string_view name) {
+        uint64_t hash = hashOf(name);
+        Shard& shard = shardFor(hash);
+        std::unique_lock lock(shard.mutex);
+        return shard.table.erase(name, hash);
+    }
+    
+    [[nodiscard]] size_t size() const {
+        size_t total = 0;
+        for (size_t i = 0; i < shardCount(); ++i) {
+            std::shared_lock lock(shards_[i].mutex);
+            total += shards_[i].table.size();
+        }
+        return total;
+    }
+    
+    [[nodiscard]] size_t shardCount() const noexcept {
+        return size_t(1) << shardBits_;
+    }
+
+private:
+    // Cache-line aligned so neighbouring shard locks do not false-share
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        HashFlatMap<Value> table;
+    };
+    
+    // Hashed once per call; the table accepts the same value precomputed
+    static uint64_t hashOf(std::string_view name) noexcept {
+        return HashFlatMap<Value>::hashOf(name);
+    }
+    
+    // The hash is already mixed. The table takes its home slot from the top
+    // bits and its tag from the low 32, so the shard uses the bits from 32 up
+    Shard& shardFor(uint64_t hash) const noexcept {
+        return shards_[static_cast<size_t>(hash >> 32) & (shardCount() - 1)];
+    }
+    
+    std::unique_ptr<Shard[]> shards_;
+    unsigned shardBits_;
+};
+
 int main() {
     std::cout << "=== Optimized RAII (Resource Acquisition Is Initialization) Principle Example ===" << std::endl;
     
@@ -422,19 +2313,64 @@ int main() {
     // Optimized example: RAII with modern C++ features
     std::cout << "\n--- Optimized Example (RAII Applied) ---" << std::endl;
     
-    ResourceManager manager;
-    
-    // Create resources (automatically managed)
-    manager.createFile("test.txt");
-    manager.createMemory(1000);
-    manager.createConnection("localhost:5432");
-    
-    // Process resources with automatic cleanup
-    manager.processAll();
+    {
+        ResourceManager manager;
+        
+        // Create resources (automatically managed)
+        manager.createFile("test.txt");
+        manager.createMemory(1000);
+        manager.createConnection("localhost:5432");
+        
+        // Process resources with automatic cleanup
+        manager.processAll();
+        
+        // Demonstrate exception safety
+        std::cout << "\n--- Exception Safety Demo ---" << std::endl;
+        manager.processWithExceptions();
+    }
+    std::remove("test.txt"); // demo file, closed when manager went away
     
-    // Demonstrate exception safety
-    std::cout << "\n--- Exception Safety Demo ---" << std::endl;
-    manager.processWithExceptions();
+    // Parallel processing with overlapped phases
+    std::cout << "\n--- Parallel processAll (Overlapped Phases) ---" << std::endl;
+    {
+        ThreadPool pool;
+        ResourceManager parallelManager;
+        for (int i = 0; i < 4; ++i) {
+            parallelManager.createFile("parallel_" + std::to_string(i) + ".txt");
+            parallelManager.createMemory(4'000'000);
+            parallelManager.createConnection("replica-" + std::to_string(i) + ":5432");
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        auto reports = parallelManager.processAllParallel(pool);
+        double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Pool threads: " << pool.size() << ", total wall time: " << totalMs << " ms" << std::endl;
+        for (const auto& report : reports) {
+            std::cout << report.name << ": " << report.items << " items, wall " << report.wallMs
+                      << " ms, busy " << report.busyMs << " ms, parallelism "
+                      << (report.wallMs > 0 ? report.busyMs / report.wallMs : 0.0) << "x" << std::endl;
+        }
+        
+        // One failing item: the rest still finish, then the error propagates
+        try {
+            TaskGroup group(pool);
+            std::atomic<int> completed{0};
+            for (int i = 0; i < 8; ++i) {
+                group.run([i, &completed] {
+                    if (i == 3) {
+                        throw std::runtime_error("item 3 failed");
+                    }
+                    ++completed;
+                });
+            }
+            group.wait();
+        } catch (const std::exception& e) {
+            std::cout << "Parallel exception propagated: " << e.what() << std::endl;
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        std::remove(("parallel_" + std::to_string(i) + ".txt").c_str());
+    }
     
     // Thread-safe resource management
     std::cout << "\n--- Thread-Safe Resource Management ---" << std::endl;
@@ -448,6 +2384,344 @@ int main() {
     
     threadSafeManager.removeResource("user");
     
+    // Backend comparison for getResource(string_view)
+    {
+        constexpr size_t resourceCount = 2'000;
+        constexpr size_t lookups = 200'000;
+        std::vector<std::string> names;
+        for (size_t i = 0; i < resourceCount; ++i) {
+            names.push_back("resource/config/entry-" + std::to_string(i));
+        }
+        std::vector<std::string_view> probes(lookups);
+        for (size_t i = 0; i < lookups; ++i) {
+            probes[i] = names[(i * 2654435761ULL) % resourceCount];
+        }
+        const std::pair<const char*, StringMapKind> kinds[] = {
+            {"std::map", StringMapKind::Tree},
+            {"sorted flat map", StringMapKind::Sorted},
+            {"hash flat map", StringMapKind::Hash},
+        };
+        std::cout << "getResource over " << resourceCount << " resources:";
+        for (const auto& [name, kind] : kinds) {
+            ThreadSafeResourceManager manager(kind);
+            // ScopedLock and addResource log every call; silence them here
+            std::streambuf* saved = std::cout.rdbuf(nullptr);
+            for (const auto& resource : names) {
+                manager.addResource(resource, "payload");
+            }
+            size_t bytes = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (std::string_view probe : probes) {
+                bytes += manager.getResource(probe).size();
+            }
+            auto end = std::chrono::steady_clock::now();
+            std::cout.rdbuf(saved);
+            std::cout.clear();
+            std::cout << " " << name << " "
+                      << std::chrono::duration<double, std::nano>(end - start).count() / lookups << " ns"
+                      << (bytes == lookups * 7 ? "" : " (lookup mismatch)") << ";";
+        }
+        std::cout << std::endl;
+    }
+    
+    // Sharded concurrent store
+    std::cout << "\n--- Sharded Resource Store ---" << std::endl;
+    {
+        ShardedResourceStore store(16);
+        store.put("config", "database=localhost");
+        store.put("user", "admin");
+        
+        // string_view lookup: no std::string is built for the key
+        constexpr std::string_view key = "config";
+        if (auto value = store.get(key)) {
+            std::cout << "Config (shared, no copy): " << *value << std::endl;
+        }
+        store.read("user", [](std::string_view value) {
+            std::cout << "User (visited in place): " << value << std::endl;
+        });
+        store.remove("user");
+        std::cout << "Entries after remove: " << store.size() << std::endl;
+        
+        // Read-heavy benchmark: 99% reads, 1% writes
+        constexpr size_t keyCount = 10000;
+        constexpr size_t opsPerThread = 400000;
+        std::vector<std::string> keys;
+        keys.reserve(keyCount);
+        for (size_t i = 0; i < keyCount; ++i) {
+            keys.push_back("resource-" + std::to_string(i));
+            store.put(keys.back(), "payload-" + std::to_string(i));
+        }
+        std::map<std::string, std::string> lockedMap;
+        std::mutex mapMutex;
+        for (size_t i = 0; i < keyCount; ++i) {
+            lockedMap[keys[i]] = "payload-" + std::to_string(i);
+        }
+        
+        auto run = [&](size_t threads, auto&& operation) {
+            std::atomic<size_t> checksum{0};
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    std::mt19937 rng(static_cast<unsigned>(t + 1));
+                    size_t local = 0;
+                    for (size_t i = 0; i < opsPerThread; ++i) {
+                        const std::string& name = keys[rng() % keyCount];
+                        local += operation(name, i % 100 == 0);
+                    }
+                    checksum += local;
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - start).count();
+            return static_cast<double>(threads * opsPerThread) / seconds / 1e6;
+        };
+        
+        std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+        for (size_t threads : {1, 2, 4, 8}) {
+            double mutexRate = run(threads, [&](const std::string& name, bool write) -> size_t {
+                std::lock_guard<std::mutex> lock(mapMutex);
+                if (write) {
+                    lockedMap[name] = "updated";
+                    return 0;
+                }
+                auto it = lockedMap.find(name);
+                return it == lockedMap.end() ? 0 : std::string(it->second).size();
+            });
+            double shardedRate = run(threads, [&](const std::string& name, bool write) -> size_t {
+                if (write) {
+                    store.put(name, "updated");
+                    return 0;
+                }
+                auto value = store.get(name);
+                return value ? value->size() : 0;
+            });
+            std::cout << threads << " thread(s): single mutex + std::map " << mutexRate
+                      << " Mops/s, sharded store " << shardedRate << " Mops/s" << std::endl;
+        }
+    }
+    
+    // Lock subsystem and contention profiling
+    std::cout << "\n--- Adaptive/Ticket Locks and Contention Profiler ---" << std::endl;
+    {
+        // Spinning locks degrade badly when contenders outnumber cores, so
+        // keep the contender count at or near the core count
+        const size_t threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 4);
+        constexpr size_t iterations = 200000;
+        
+        auto contend = [&](const char* label, auto& mutex) {
+            long long counter = 0;
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < threads; ++t) {
+                workers.emplace_back([&] {
+                    for (size_t i = 0; i < iterations; ++i) {
+                        std::lock_guard<std::decay_t<decltype(mutex)>> lock(mutex);
+                        ++counter;
+                    }
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            auto end = std::chrono::steady_clock::now();
+            double ns = std::chrono::duration<double, std::nano>(end - start).count();
+            std::cout << label << ": " << ns / static_cast<double>(threads * iterations)
+                      << " ns/acquisition (counter " << counter << ")" << std::endl;
+        };
+        
+        std::mutex stdMutex;
+        AdaptiveMutex adaptive;
+        TicketLock ticket;
+        contend("std::mutex   ", stdMutex);
+        contend("AdaptiveMutex", adaptive);
+        contend("TicketLock   ", ticket);
+        
+        // Two instrumented sites guarding the same lock with different hold times
+        static LockSite fastSite("inventory.update (short hold)");
+        static LockSite slowSite("inventory.rebuild (long hold)");
+        AdaptiveMutex inventoryMutex;
+        long long inventory = 0;
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (size_t i = 0; i < 20000; ++i) {
+                    if (t == 0 && i % 1000 == 0) {
+                        ProfiledLockGuard<AdaptiveMutex> guard(inventoryMutex, slowSite);
+                        for (int k = 0; k < 20000; ++k) {
+                            inventory += k & 1;
+                        }
+                    } else {
+                        ProfiledLockGuard<AdaptiveMutex> guard(inventoryMutex, fastSite);
+                        ++inventory;
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        std::cout << "Inventory: " << inventory << std::endl;
+        LockSite::dumpAll(std::cout);
+    }
+    
+#if RAII_TRACING
+    // Hierarchical tracing
+    std::cout << "\n--- Hierarchical Tracing ---" << std::endl;
+    {
+        Tracer& tracer = Tracer::instance();
+        tracer.clear();
+        
+        auto parseRecord = [](int value) {
+            RAII_TRACE_SCOPE("parseRecord");
+            long long sum = 0;
+            for (int i = 0; i < 200; ++i) sum += (value * i) % 7;
+            return sum;
+        };
+        auto loadBatch = [&](int batch) {
+            RAII_TRACE_SCOPE("loadBatch");
+            long long sum = 0;
+            for (int i = 0; i < 20; ++i) sum += parseRecord(batch * 20 + i);
+            return sum;
+        };
+        
+        long long total = 0;
+        std::vector<std::thread> workers;
+        std::mutex totalMutex;
+        for (int t = 0; t < 2; ++t) {
+            workers.emplace_back([&, t] {
+                RAII_TRACE_SCOPE("worker");
+                long long local = 0;
+                for (int batch = 0; batch < 5; ++batch) local += loadBatch(t * 5 + batch);
+                std::lock_guard<std::mutex> lock(totalMutex);
+                total += local;
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        std::cout << "Work checksum: " << total << std::endl;
+        tracer.printSummary(std::cout);
+        
+        const std::string tracePath = "raii_trace.json";
+        std::streamoff traceBytes = 0;
+        {
+            std::ofstream traceFile(tracePath);
+            tracer.writeChromeTrace(traceFile);
+            traceBytes = traceFile.tellp();
+        }
+        std::remove(tracePath.c_str());
+        std::cout << "Chrome trace: " << traceBytes << " bytes written to " << tracePath
+                  << " (removed after the demo)" << std::endl;
+        
+        // Per-scope overhead of an empty traced scope
+        tracer.clear();
+        constexpr int scopes = 1'000'000;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < scopes; ++i) {
+            RAII_TRACE_SCOPE("empty");
+        }
+        auto end = std::chrono::steady_clock::now();
+        std::cout << "Tracing overhead: "
+                  << std::chrono::duration<double, std::nano>(end - start).count() / scopes
+                  << " ns/scope" << std::endl;
+        tracer.clear();
+    }
+#endif
+    
+    // Connection pooling
+    std::cout << "\n--- Connection Pool with Lease Guards ---" << std::endl;
+    {
+        ConnectionPool<DatabaseConnection>::Options dbOptions;
+        dbOptions.minSize = 1;
+        dbOptions.maxSize = 2;
+        ConnectionPool<DatabaseConnection> dbPool(
+            [] { return std::make_unique<DatabaseConnection>("localhost:5432"); }, dbOptions);
+        {
+            auto lease = dbPool.lease();
+            lease->executeQuery("SELECT 1");
+        } // returned to the pool, not disconnected
+        {
+            auto lease = dbPool.lease();  // reuses the same connection
+            lease->executeQuery("SELECT 2");
+        }
+        
+        const auto connectLatency = std::chrono::microseconds(500);
+        ConnectionPool<SimulatedConnection>::Options options;
+        options.minSize = 2;
+        options.maxSize = 4;
+        options.idleTimeout = std::chrono::milliseconds(50);
+        ConnectionPool<SimulatedConnection> pool(
+            [connectLatency] { return std::make_unique<SimulatedConnection>("sim://db", connectLatency); },
+            options);
+        std::cout << "Warmed up: " << pool.openConnections() << " open, "
+                  << pool.idleConnections() << " idle" << std::endl;
+        
+        constexpr size_t threads = 8;
+        constexpr size_t queriesPerThread = 200;
+        auto runWorkers = [&](auto&& query) {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < threads; ++t) {
+                workers.emplace_back([&] {
+                    for (size_t i = 0; i < queriesPerThread; ++i) {
+                        query();
+                    }
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+        
+        // Each query also holds its connection for a short server round trip
+        const auto queryTime = std::chrono::microseconds(50);
+        std::atomic<int> peakLive{0};
+        double perUseMs = runWorkers([&] {
+            SimulatedConnection connection("sim://db", connectLatency);
+            connection.executeQuery("SELECT * FROM data");
+            std::this_thread::sleep_for(queryTime);
+        });
+        double pooledMs = runWorkers([&] {
+            auto lease = pool.lease();
+            lease->executeQuery("SELECT * FROM data");
+            std::this_thread::sleep_for(queryTime);
+            int live = SimulatedConnection::liveConnections().load();
+            int peak = peakLive.load();
+            while (live > peak && !peakLive.compare_exchange_weak(peak, live)) {
+            }
+        });
+        std::cout << "Connect-per-use: " << perUseMs << " ms for " << threads * queriesPerThread << " queries" << std::endl;
+        std::cout << "Pooled leases:   " << pooledMs << " ms" << std::endl;
+        
+        auto metrics = pool.metrics();
+        std::cout << "Pool metrics: leases=" << metrics.leases << " created=" << metrics.created
+                  << " waits=" << metrics.waits << " avgWait="
+                  << (metrics.waits ? metrics.totalWaitMs / static_cast<double>(metrics.waits) : 0.0)
+                  << "ms maxWait=" << metrics.maxWaitMs << "ms peakInUse=" << metrics.peakInUse << std::endl;
+        std::cout << "Max size respected: " << (peakLive.load() <= static_cast<int>(options.maxSize) ? "yes" : "no")
+                  << " (peak live " << peakLive.load() << ")" << std::endl;
+        
+        // Idle reaping trims back to minSize
+        pool.startReaper(std::chrono::milliseconds(20));
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+        pool.stopReaper();
+        std::cout << "After idle reaping: " << pool.openConnections() << " open (min "
+                  << options.minSize << "), reaped " << pool.metrics().reaped << std::endl;
+        
+        // A throwing user still returns its connection
+        try {
+            auto lease = pool.lease();
+            throw std::runtime_error("query failed");
+        } catch (const std::exception& e) {
+            std::cout << "Exception: " << e.what() << ", idle connections: " << pool.idleConnections() << std::endl;
+        }
+    }
+    
     // Demonstrate move semantics
     std::cout << "\n--- Move Semantics Demo ---" << std::endl;
     {
@@ -458,6 +2732,194 @@ int main() {
         file2.writeLine("Hello from file2");
         // file1 is now in moved-from state, file2 owns the resource
     } // Both files are automatically closed
+    std::remove("test1.txt");
+    
+#if RAII_HAS_POSIX_IO
+    // Zero-copy reading and block-buffered writing
+    std::cout << "\n--- Memory-Mapped Reader and Buffered Writer ---" << std::endl;
+    {
+        const std::string path = "raii_io_benchmark.txt";
+        const size_t lineCount = 500000;
+        const std::string payload = "sensor=42 value=3.14159 status=OK id=";
+        
+        auto report = [](const char* label, size_t bytes, auto start, auto end) {
+            double seconds = std::chrono::duration<double>(end - start).count();
+            std::cout << label << ": " << bytes / (1024 * 1024) << " MB in "
+                      << seconds * 1000.0 << " ms, "
+                      << static_cast<double>(bytes) / seconds / 1e9 << " GB/s" << std::endl;
+        };
+        
+        // Write: fstream with std::endl (previous writeLine) vs BufferedFileWriter
+        auto start = std::chrono::steady_clock::now();
+        {
+            std::ofstream out(path);
+            for (size_t i = 0; i < lineCount; ++i) {
+                out << payload << i << std::endl;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        size_t fileBytes = 0;
+        {
+            MappedFileReader probe(path);
+            fileBytes = probe.size();
+        }
+        report("Write fstream + std::endl ", fileBytes, start, end);
+        
+        start = std::chrono::steady_clock::now();
+        {
+            BufferedFileWriter writer(path);
+            std::string line;
+            for (size_t i = 0; i < lineCount; ++i) {
+                line.assign(payload);
+                line += std::to_string(i);
+                writer.writeLine(line);
+            }
+            writer.close();
+        }
+        end = std::chrono::steady_clock::now();
+        report("Write BufferedFileWriter  ", fileBytes, start, end);
+        
+        // Read: std::getline into a new string per line vs string_view over the mapping
+        start = std::chrono::steady_clock::now();
+        size_t getlineLines = 0;
+        size_t getlineBytes = 0;
+        {
+            std::ifstream in(path);
+            std::string line;
+            while (std::getline(in, line)) {
+                ++getlineLines;
+                getlineBytes += line.size();
+            }
+        }
+        end = std::chrono::steady_clock::now();
+        report("Read std::getline         ", fileBytes, start, end);
+        
+        start = std::chrono::steady_clock::now();
+        size_t mappedBytes = 0;
+        size_t mappedLines = 0;
+        {
+            MappedFileReader reader(path);
+            mappedLines = reader.forEachLine([&mappedBytes](std::string_view line) {
+                mappedBytes += line.size();
+            });
+        }
+        end = std::chrono::steady_clock::now();
+        report("Read MappedFileReader     ", fileBytes, start, end);
+        std::cout << "Lines read: " << getlineLines << " vs " << mappedLines
+                  << (getlineBytes == mappedBytes ? " (contents match)" : " (MISMATCH)") << std::endl;
+        
+        std::remove(path.c_str());
+    }
+#endif
+    
+#if RAII_HAS_POSIX_IO
+    // Pooled and arena-backed memory
+    std::cout << "\n--- Size-Class Pool and Arena ---" << std::endl;
+    {
+        SizeClassPool pool;
+        {
+            PooledIntBuffer buffer(pool, 100);
+            for (size_t i = 0; i < buffer.size(); ++i) {
+                buffer[i] = static_cast<int>(i * i);
+            }
+            std::cout << "Pooled buffer[9] = " << buffer[9] << std::endl;
+        } // block returned to its size class
+        
+        MonotonicArena arena;
+        {
+            ScopedArenaReset scope(arena);
+            int* scratch = arena.allocateArray<int>(1000);
+            scratch[999] = 7;
+            std::cout << "Arena scratch[999] = " << scratch[999] << std::endl;
+        } // arena rewound, chunk kept for reuse
+        std::cout << "Arena reserved bytes: " << arena.reservedBytes() << std::endl;
+        
+        // Allocation rate: mixed small sizes, allocate/free in batches
+        constexpr size_t rounds = 50;
+        constexpr size_t batch = 20000;
+        std::vector<size_t> sizes(batch);
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<size_t> sizeDist(8, 1024);
+        for (auto& size : sizes) {
+            size = sizeDist(rng);
+        }
+        std::vector<void*> pointers(batch);
+        
+        auto rate = [&](const char* label, auto start, auto end) {
+            double seconds = std::chrono::duration<double>(end - start).count();
+            std::cout << label << ": " << static_cast<double>(rounds * batch) / seconds / 1e6
+                      << " M allocs/s" << std::endl;
+        };
+        
+        auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < batch; ++i) pointers[i] = ::operator new(sizes[i]);
+            for (size_t i = 0; i < batch; ++i) ::operator delete(pointers[i]);
+        }
+        auto end = std::chrono::steady_clock::now();
+        rate("operator new/delete", start, end);
+        
+        start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < batch; ++i) pointers[i] = pool.allocate(sizes[i]);
+            for (size_t i = 0; i < batch; ++i) pool.deallocate(pointers[i], sizes[i]);
+        }
+        end = std::chrono::steady_clock::now();
+        rate("SizeClassPool      ", start, end);
+        
+        start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            ScopedArenaReset scope(arena);
+            for (size_t i = 0; i < batch; ++i) pointers[i] = arena.allocate(sizes[i]);
+        }
+        end = std::chrono::steady_clock::now();
+        rate("MonotonicArena     ", start, end);
+        
+        // First touch: allocate + fill a large buffer once
+        constexpr size_t count = 16 * 1024 * 1024;  // 64 MiB of ints
+        auto touch = [&](const char* label, auto&& allocateAndFill) {
+            auto begin = std::chrono::steady_clock::now();
+            long long checksum = allocateAndFill();
+            auto finish = std::chrono::steady_clock::now();
+            std::cout << label << ": "
+                      << std::chrono::duration<double, std::milli>(finish - begin).count()
+                      << " ms (checksum " << checksum << ")" << std::endl;
+        };
+        auto fill = [](int* data) {
+            for (size_t i = 0; i < count; ++i) data[i] = static_cast<int>(i);
+            return static_cast<long long>(data[count - 1]);
+        };
+        
+        touch("make_unique<int[]> + fill (zero, then write)", [&] {
+            auto data = std::make_unique<int[]>(count);
+            return fill(data.get());
+        });
+        touch("new int[] + fill (default-init)             ", [&] {
+            std::unique_ptr<int[]> data(new int[count]);
+            return fill(data.get());
+        });
+        touch("MappedRegion + fill                         ", [&] {
+            MappedRegion region(count * sizeof(int));
+            return fill(static_cast<int*>(region.data()));
+        });
+        PageOptions thp;
+        thp.transparentHugePages = true;
+        touch("MappedRegion (THP) + fill                   ", [&] {
+            MappedRegion region(count * sizeof(int), thp);
+            return fill(static_cast<int*>(region.data()));
+        });
+        PageOptions huge;
+        huge.hugePages = true;
+        huge.numaNode = 0;
+        bool gotHugePages = false;
+        touch("MappedRegion (MAP_HUGETLB, node 0) + fill   ", [&] {
+            MappedRegion region(count * sizeof(int), huge);
+            gotHugePages = region.usesHugePages();
+            return fill(static_cast<int*>(region.data()));
+        });
+        std::cout << "Explicit huge pages available: " << (gotHugePages ? "yes" : "no (fell back)") << std::endl;
+    }
+#endif
     
     return 0;
 } 
\ No newline at end of file
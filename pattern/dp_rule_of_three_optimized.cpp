@@ -3,6 +3,15 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <chrono>
+#include <atomic>
+#include <new>
+#include <utility>
+#include <stdexcept>
 
 // Optimized Rule of Three/Five/Zero Example
 // Using modern C++17/20 features for better performance and safety
@@ -148,6 +157,175 @@ private:
     std::string name_; // RAII-managed resource
 };
 
+// Immutable-once-shared int buffer with an intrusive reference count
+// The count lives in the same allocation as the data, so sharing costs one
+// atomic increment and no extra control block. Rule of Five applies here
+// because the handle itself owns the allocation.
+class SharedIntBuffer {
+public:
+    SharedIntBuffer() noexcept = default;
+    
+    explicit SharedIntBuffer(size_t size) : block_(allocate(size)) {}
+    
+    SharedIntBuffer(const int* data, size_t size) : block_(allocate(size)) {
+        std::copy(data, data + size, block_->data());
+    }
+    
+    SharedIntBuffer(const SharedIntBuffer& other) noexcept : block_(other.block_) {
+        if (block_) {
+            block_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    SharedIntBuffer(SharedIntBuffer&& other) noexcept : block_(std::exchange(other.block_, nullptr)) {}
+    
+    SharedIntBuffer& operator=(const SharedIntBuffer& other) noexcept {
+        SharedIntBuffer copy(other);
+        std::swap(block_, copy.block_);
+        return *this;
+    }
+    
+    SharedIntBuffer& operator=(SharedIntBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            block_ = std::exchange(other.block_, nullptr);
+        }
+        return *this;
+    }
+    
+    ~SharedIntBuffer() {
+        release();
+    }
+    
+    [[nodiscard]] const int* data() const noexcept {
+        return block_ ? block_->data() : nullptr;
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return block_ ? block_->size : 0;
+    }
+    
+    [[nodiscard]] bool unique() const noexcept {
+        // Acquire pairs with the release in other handles' release(), so
+        // their reads of the buffer happen before we start writing to it
+        return block_ && block_->refs.load(std::memory_order_acquire) == 1;
+    }
+    
+    [[nodiscard]] uint32_t useCount() const noexcept {
+        return block_ ? block_->refs.load(std::memory_order_relaxed) : 0;
+    }
+    
+    // Writable pointer; clones the buffer first if anyone else shares it
+    [[nodiscard]] int* mutableData() {
+        if (block_ && !unique()) {
+            SharedIntBuffer clone(block_->data(), block_->size);
+            std::swap(block_, clone.block_);
+        }
+        return block_ ? block_->data() : nullptr;
+    }
+
+private:
+    struct Block {
+        std::atomic<uint32_t> refs{1};
+        size_t size;
+        
+        explicit Block(size_t count) : size(count) {}
+        
+        int* data() noexcept {
+            return reinterpret_cast<int*>(this + 1);
+        }
+    };
+    
+    static Block* allocate(size_t size) {
+        if (size > (SIZE_MAX - sizeof(Block)) / sizeof(int)) {
+            throw std::bad_array_new_length();
+        }
+        void* memory = ::operator new(sizeof(Block) + size * sizeof(int));
+        return ::new (memory) Block(size);
+    }
+    
+    void release() noexcept {
+        if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            block_->~Block();
+            ::operator delete(block_);
+        }
+        block_ = nullptr;
+    }
+    
+    Block* block_ = nullptr;
+};
+
+// Read-only window over a resource's data for bulk consumers
+struct IntView {
+    const int* data = nullptr;
+    size_t size = 0;
+    
+    [[nodiscard]] const int* begin() const noexcept { return data; }
+    [[nodiscard]] const int* end() const noexcept { return data + size; }
+    [[nodiscard]] int operator[](size_t index) const noexcept { return data[index]; }
+};
+
+// Copy-on-write resource manager (Rule of Zero on top of SharedIntBuffer)
+// Copies share the buffer; the first setValue/fillData on a shared copy
+// clones it, so read-mostly buffers pass between stages without deep copies.
+class CowResourceManager {
+public:
+    CowResourceManager(std::string name, size_t size) 
+        : name_(std::move(name)), buffer_(size) {
+        std::fill_n(buffer_.mutableData(), size, 0);
+    }
+    
+    CowResourceManager(std::string name, const int* data, size_t size)
+        : name_(std::move(name)), buffer_(data, size) {}
+    
+    void fillData() {
+        int* data = buffer_.mutableData();
+        for (size_t i = 0; i < buffer_.size(); ++i) {
+            data[i] = static_cast<int>(i);
+        }
+    }
+    
+    [[nodiscard]] int getValue(size_t index) const {
+        if (index < buffer_.size()) {
+            return buffer_.data()[index];
+        }
+        throw std::out_of_range("Index out of range");
+    }
+    
+    void setValue(size_t index, int value) {
+        if (index < buffer_.size()) {
+            buffer_.mutableData()[index] = value;
+        } else {
+            throw std::out_of_range("Index out of range");
+        }
+    }
+    
+    // Valid until this manager is next modified or destroyed
+    [[nodiscard]] IntView view() const noexcept {
+        return {buffer_.data(), buffer_.size()};
+    }
+    
+    [[nodiscard]] bool sharesBufferWith(const CowResourceManager& other) const noexcept {
+        return buffer_.data() == other.buffer_.data();
+    }
+    
+    [[nodiscard]] uint32_t useCount() const noexcept {
+        return buffer_.useCount();
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return buffer_.size();
+    }
+    
+    [[nodiscard]] const std::string& getName() const noexcept {
+        return name_;
+    }
+
+private:
+    std::string name_;
+    SharedIntBuffer buffer_;
+};
+
 // Modern resource manager using smart pointers (Rule of Zero)
 class ModernResourceManager {
 public:
@@ -187,6 +365,11 @@ public:
     [[nodiscard]] const std::string& getName() const noexcept {
         return name_;
     }
+    
+    // Snapshot into a copy-on-write manager; the one deep copy happens here
+    [[nodiscard]] CowResourceManager share() const {
+        return CowResourceManager(name_, data_.get(), size_);
+    }
 
 private:
     std::string name_;
@@ -227,6 +410,205 @@ private:
     std::vector<std::string> items_; // RAII-managed container
 };
 
+// Hash-indexed container (Rule of Zero: only vectors own memory)
+// - entries_ keeps insertion order in one flat vector
+// - strings up to kInlineCapacity bytes live inside their entry, longer ones
+//   in a shared character arena, so there is no per-item heap allocation
+// - every entry carries its full hash, and each index slot a copy of it, so
+//   probes reject mismatches without touching string bytes
+// - an open-addressing index gives O(1) contains/remove; removal leaves a
+//   tombstone and the container compacts itself once half the entries are dead
+// Unlike ModernContainer, items are unique: addItem ignores duplicates.
+class IndexedContainer {
+public:
+    IndexedContainer() = default;
+    
+    bool addItem(std::string_view item) {
+        const uint64_t hash = hashOf(item);
+        if (findSlot(item, hash) != npos) {
+            return false;
+        }
+        if ((live_ + deadEntries_ + 1) * 4 > index_.size() * 3) {
+            rebuildIndex(std::max<size_t>(16, index_.size() * 2));
+        }
+        Entry entry{};
+        entry.hash = hash;
+        entry.length = static_cast<uint32_t>(item.size());
+        if (item.size() <= kInlineCapacity) {
+            std::memcpy(entry.inlineChars, item.data(), item.size());
+        } else {
+            entry.arenaOffset = arena_.size();
+            arena_.insert(arena_.end(), item.begin(), item.end());
+        }
+        insertIntoIndex(static_cast<uint32_t>(entries_.size()), hash);
+        entries_.push_back(entry);
+        ++live_;
+        return true;
+    }
+    
+    bool removeItem(std::string_view item) {
+        size_t slot = findSlot(item, hashOf(item));
+        if (slot == npos) {
+            return false;
+        }
+        entries_[index_[slot].entry].length = kDead;
+        index_[slot].entry = kTombstone;
+        --live_;
+        ++deadEntries_;
+        if (deadEntries_ > 64 && deadEntries_ > live_) {
+            compact();
+        }
+        return true;
+    }
+    
+    [[nodiscard]] bool contains(std::string_view item) const {
+        return findSlot(item, hashOf(item)) != npos;
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return live_;
+    }
+    
+    // Visits items in insertion order
+    template<typename Func>
+    void forEach(Func&& func) const {
+        for (const auto& entry : entries_) {
+            if (entry.length != kDead) {
+                func(view(entry));
+            }
+        }
+    }
+    
+    [[nodiscard]] std::vector<std::string_view> getItems() const {
+        std::vector<std::string_view> items;
+        items.reserve(live_);
+        forEach([&items](std::string_view item) { items.push_back(item); });
+        return items;
+    }
+    
+    void reserve(size_t count) {
+        entries_.reserve(count);
+        if (count * 4 > index_.size() * 3) {
+            size_t capacity = 16;
+            while (count * 4 > capacity * 3) {
+                capacity *= 2;
+            }
+            rebuildIndex(capacity);
+        }
+    }
+
+private:
+    static constexpr size_t kInlineCapacity = 16;
+    static constexpr uint32_t kDead = UINT32_MAX;
+    static constexpr uint32_t kEmpty = UINT32_MAX;
+    static constexpr uint32_t kTombstone = UINT32_MAX - 1;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    
+    struct Entry {
+        uint64_t hash;
+        uint32_t length;  // kDead once removed
+        union {
+            char inlineChars[kInlineCapacity];
+            size_t arenaOffset;
+        };
+    };
+    
+    struct Slot {
+        uint32_t entry = kEmpty;
+        uint32_t hashTag = 0;  // low 32 bits of the hash
+    };
+    
+    // Fibonacci mixing spreads every bit of std::hash (32-bit on some
+    // platforms) into the high bits that pick the home slot
+    static uint64_t hashOf(std::string_view item) noexcept {
+        return static_cast<uint64_t>(std::hash<std::string_view>{}(item)) * 0x9E3779B97F4A7C15ull;
+    }
+    
+    size_t homeOf(uint64_t hash) const noexcept {
+        return static_cast<size_t>(hash >> indexShift_);
+    }
+    
+    std::string_view view(const Entry& entry) const noexcept {
+        if (entry.length <= kInlineCapacity) {
+            return {entry.inlineChars, entry.length};
+        }
+        return {arena_.data() + entry.arenaOffset, entry.length};
+    }
+    
+    size_t findSlot(std::string_view item, uint64_t hash) const noexcept {
+        if (index_.empty()) {
+            return npos;
+        }
+        const size_t mask = index_.size() - 1;
+        const auto tag = static_cast<uint32_t>(hash);
+        for (size_t i = homeOf(hash);; i = (i + 1) & mask) {
+            const Slot& slot = index_[i];
+            if (slot.entry == kEmpty) {
+                return npos;
+            }
+            if (slot.entry != kTombstone && slot.hashTag == tag) {
+                const Entry& entry = entries_[slot.entry];
+                if (entry.hash == hash && view(entry) == item) {
+                    return i;
+                }
+            }
+        }
+    }
+    
+    void insertIntoIndex(uint32_t entryIndex, uint64_t hash) noexcept {
+        const size_t mask = index_.size() - 1;
+        for (size_t i = homeOf(hash);; i = (i + 1) & mask) {
+            if (index_[i].entry == kEmpty || index_[i].entry == kTombstone) {
+                index_[i] = {entryIndex, static_cast<uint32_t>(hash)};
+                return;
+            }
+        }
+    }
+    
+    void rebuildIndex(size_t capacity) {
+        index_.assign(capacity, Slot{});
+        indexShift_ = 64;
+        for (size_t bits = capacity; bits > 1; bits >>= 1) {
+            --indexShift_;
+        }
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            if (entries_[i].length != kDead) {
+                insertIntoIndex(static_cast<uint32_t>(i), entries_[i].hash);
+            }
+        }
+    }
+    
+    // Drops dead entries and their arena bytes, preserving insertion order
+    void compact() {
+        std::vector<Entry> entries;
+        std::vector<char> arena;
+        entries.reserve(live_);
+        for (const auto& entry : entries_) {
+            if (entry.length == kDead) {
+                continue;
+            }
+            Entry moved = entry;
+            if (entry.length > kInlineCapacity) {
+                moved.arenaOffset = arena.size();
+                std::string_view text = view(entry);
+                arena.insert(arena.end(), text.begin(), text.end());
+            }
+            entries.push_back(moved);
+        }
+        entries_ = std::move(entries);
+        arena_ = std::move(arena);
+        deadEntries_ = 0;
+        rebuildIndex(index_.size());
+    }
+    
+    std::vector<Entry> entries_;
+    std::vector<char> arena_;
+    std::vector<Slot> index_;
+    unsigned indexShift_ = 64;  // 64 - log2(index_.size())
+    size_t live_ = 0;
+    size_t deadEntries_ = 0;
+};
+
 // Modern factory using Rule of Zero
 class ModernFactory {
 public:
@@ -292,8 +674,10 @@ private:
     ~ModernSingleton() = default;
 };
 
-int main() {
+int main(int argc, char* argv[]) {
     std::cout << "=== Optimized Rule of Three/Five/Zero Example ===" << std::endl;
+    // --large adds the 1e7-item container benchmark (several GB of RAM)
+    const bool largeBenchmarks = argc > 1 && std::string_view(argv[1]) == "--large";
     
     // Bad example: No special member functions
     std::cout << "\n--- Bad Example (No Special Member Functions) ---" << std::endl;
@@ -343,6 +727,82 @@ int main() {
         std::cout << "Manager2 value at index 5: " << manager2.getValue(5) << std::endl;
     }
     
+    // Copy-on-write resource manager example
+    std::cout << "\n--- Copy-on-Write Resource Manager Example ---" << std::endl;
+    {
+        ModernResourceManager source = ModernFactory::createManager("Source", 100);
+        source.fillData();
+        
+        CowResourceManager stage1 = source.share();
+        CowResourceManager stage2 = stage1; // Shares the buffer
+        std::cout << "Shared after copy: " << (stage1.sharesBufferWith(stage2) ? "Yes" : "No")
+                  << " (use count " << stage1.useCount() << ")" << std::endl;
+        
+        stage2.setValue(5, 500); // First write clones
+        std::cout << "Shared after setValue: " << (stage1.sharesBufferWith(stage2) ? "Yes" : "No") << std::endl;
+        std::cout << "Stage1 value at index 5: " << stage1.getValue(5) << std::endl;
+        std::cout << "Stage2 value at index 5: " << stage2.getValue(5) << std::endl;
+        
+        long long sum = 0;
+        for (int value : stage1.view()) {
+            sum += value;
+        }
+        std::cout << "Stage1 sum via view(): " << sum << std::endl;
+    }
+    
+    // Stage hand-off benchmark: deep copy vs copy-on-write
+    std::cout << "\n--- Buffer Hand-off Benchmark ---" << std::endl;
+    {
+        constexpr size_t bufferSize = 16 * 1024 * 1024; // 64 MiB of ints
+        constexpr int stages = 8;
+        auto msSince = [](auto start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+        auto sumOf = [](const int* data, size_t size) {
+            long long sum = 0;
+            for (size_t i = 0; i < size; ++i) {
+                sum += data[i];
+            }
+            return sum;
+        };
+        
+        ModernResourceManager source("Source", bufferSize);
+        source.fillData();
+        
+        // Each stage receives its own deep copy, as a copyable int[] owner would
+        auto start = std::chrono::steady_clock::now();
+        long long deepSum = 0;
+        {
+            std::vector<int> current(bufferSize);
+            for (size_t i = 0; i < bufferSize; ++i) {
+                current[i] = source.getValue(i);
+            }
+            for (int stage = 0; stage < stages; ++stage) {
+                std::vector<int> next = current;
+                deepSum += sumOf(next.data(), next.size());
+                current = std::move(next);
+            }
+        }
+        double deepMs = msSince(start);
+        
+        start = std::chrono::steady_clock::now();
+        long long cowSum = 0;
+        {
+            CowResourceManager current = source.share();
+            for (int stage = 0; stage < stages; ++stage) {
+                CowResourceManager next = current;
+                IntView view = next.view();
+                cowSum += sumOf(view.data, view.size);
+                current = std::move(next);
+            }
+        }
+        double cowMs = msSince(start);
+        
+        std::cout << stages << " stages x " << (bufferSize * sizeof(int)) / (1024 * 1024) << " MiB: deep copy "
+                  << deepMs << " ms, copy-on-write " << cowMs << " ms"
+                  << (deepSum == cowSum ? "" : " (checksum mismatch)") << std::endl;
+    }
+    
     // Modern container example
     std::cout << "\n--- Modern Container Example ---" << std::endl;
     {
@@ -360,6 +820,88 @@ int main() {
         }
     }
     
+    // Indexed container example
+    std::cout << "\n--- Indexed Container Example ---" << std::endl;
+    {
+        IndexedContainer container;
+        container.addItem("Item1");
+        container.addItem("Item2");
+        container.addItem("a-much-longer-item-that-lives-in-the-arena");
+        container.addItem("Item3");
+        bool duplicateAdded = container.addItem("Item2");
+        container.removeItem("Item1");
+        
+        std::cout << "Container size: " << container.size() << std::endl;
+        std::cout << "Duplicate added: " << (duplicateAdded ? "Yes" : "No") << std::endl;
+        std::cout << "Contains Item2: " << (container.contains("Item2") ? "Yes" : "No") << std::endl;
+        std::cout << "Contains Item1: " << (container.contains("Item1") ? "Yes" : "No") << std::endl;
+        container.forEach([](std::string_view item) {
+            std::cout << "Item: " << item << std::endl;
+        });
+    }
+    
+    // contains/remove benchmark: linear scan vs hash index
+    std::cout << "\n--- Container Lookup Benchmark ---" << std::endl;
+    {
+        std::vector<size_t> sizes{1'000, 10'000, 100'000, 1'000'000};
+        if (largeBenchmarks) {
+            sizes.push_back(10'000'000);
+        }
+        auto nsPerOp = [](auto start, auto end, size_t ops) {
+            return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(ops);
+        };
+        for (size_t count : sizes) {
+            std::vector<std::string> keys;
+            keys.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                // Mix of inline-sized and arena-sized strings
+                keys.push_back((i % 4 == 0 ? "long-item-name-for-arena-" : "item-") + std::to_string(i));
+            }
+            
+            ModernContainer linear;
+            IndexedContainer indexed;
+            indexed.reserve(count);
+            for (const auto& key : keys) {
+                linear.addItem(key);
+                indexed.addItem(key);
+            }
+            
+            // The linear scan is O(n) per lookup, so it gets fewer probes
+            const size_t linearOps = std::max<size_t>(10, 2'000'000 / count);
+            const size_t indexedOps = 1'000'000;
+            size_t hits = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < linearOps; ++i) {
+                hits += linear.contains(keys[(i * 2654435761ULL) % count]);
+            }
+            auto end = std::chrono::steady_clock::now();
+            double linearNs = nsPerOp(start, end, linearOps);
+            
+            start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < indexedOps; ++i) {
+                hits += indexed.contains(keys[(i * 2654435761ULL) % count]);
+            }
+            end = std::chrono::steady_clock::now();
+            double indexedNs = nsPerOp(start, end, indexedOps);
+            
+            // Remove and re-add a slice to exercise tombstones and compaction
+            const size_t churn = std::min<size_t>(count / 2, 100'000);
+            start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < churn; ++i) {
+                indexed.removeItem(keys[i]);
+            }
+            for (size_t i = 0; i < churn; ++i) {
+                indexed.addItem(keys[i]);
+            }
+            end = std::chrono::steady_clock::now();
+            double churnNs = nsPerOp(start, end, churn * 2);
+            
+            std::cout << count << " items: ModernContainer::contains " << linearNs
+                      << " ns, IndexedContainer::contains " << indexedNs
+                      << " ns, remove/add " << churnNs << " ns (hits " << hits << ")" << std::endl;
+        }
+    }
+    
     // Optimized manager example
     std::cout << "\n--- Optimized Manager Example ---" << std::endl;
     {
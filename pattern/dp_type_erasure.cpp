@@ -3,6 +3,16 @@
 #include <memory>
 #include <vector>
 #include <functional>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 
 // Type Erasure Pattern
 // Runtime polymorphism without inheritance
@@ -119,6 +129,215 @@ private:
     std::unique_ptr<CallableConcept> pImpl;
 };
 
+// Serialization buffers
+// A caller-owned, growable byte buffer. clear() keeps the capacity, so a
+// buffer reused across calls stops allocating once it has warmed up.
+class ByteBuffer {
+public:
+    ByteBuffer() = default;
+    explicit ByteBuffer(size_t capacity) { reserve(capacity); }
+    
+    ByteBuffer(const ByteBuffer&) = delete;
+    ByteBuffer& operator=(const ByteBuffer&) = delete;
+    ByteBuffer(ByteBuffer&& other) noexcept
+        : storage(std::move(other.storage)), used(other.used), allocated(other.allocated) {
+        other.used = 0;
+        other.allocated = 0;
+    }
+    
+    ByteBuffer& operator=(ByteBuffer&& other) noexcept {
+        if (this != &other) {
+            storage = std::move(other.storage);
+            used = std::exchange(other.used, 0);
+            allocated = std::exchange(other.allocated, 0);
+        }
+        return *this;
+    }
+    
+    void reserve(size_t capacity) {
+        if (capacity <= allocated) {
+            return;
+        }
+        std::unique_ptr<char[]> grown(new char[capacity]);  // no zero-fill
+        if (used > 0) {
+            std::memcpy(grown.get(), storage.get(), used);
+        }
+        storage = std::move(grown);
+        allocated = capacity;
+    }
+    
+    // Returns room for at least n bytes at the end; follow with commit().
+    char* prepare(size_t n) {
+        if (used + n > allocated) {
+            reserve(std::max(allocated * 2, used + n));
+        }
+        return storage.get() + used;
+    }
+    
+    void commit(size_t n) noexcept { used += n; }
+    
+    void append(const void* bytes, size_t n) {
+        std::memcpy(prepare(n), bytes, n);
+        commit(n);
+    }
+    
+    void append(std::string_view text) { append(text.data(), text.size()); }
+    
+    void push(char byte) {
+        *prepare(1) = byte;
+        commit(1);
+    }
+    
+    void clear() noexcept { used = 0; }
+    
+    const char* data() const noexcept { return storage.get(); }
+    size_t size() const noexcept { return used; }
+    size_t capacity() const noexcept { return allocated; }
+    std::string_view view() const noexcept { return {storage.get(), used}; }
+    
+private:
+    std::unique_ptr<char[]> storage;
+    size_t used = 0;
+    size_t allocated = 0;
+};
+
+// Compact binary format: LEB128 varints (zigzag for signed values),
+// length-prefixed strings and little-endian 8-byte doubles.
+class BinaryWriter {
+public:
+    explicit BinaryWriter(ByteBuffer& buffer) : buffer(buffer) {}
+    
+    void writeVarint(uint64_t value) {
+        char* out = buffer.prepare(10);
+        size_t n = 0;
+        while (value >= 0x80) {
+            out[n++] = static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out[n++] = static_cast<char>(value);
+        buffer.commit(n);
+    }
+    
+    void writeSigned(int64_t value) {
+        writeVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+    
+    void writeDouble(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        char* out = buffer.prepare(8);
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<char>(bits >> (8 * i));
+        }
+        buffer.commit(8);
+    }
+    
+    void writeString(std::string_view text) {
+        writeVarint(text.size());
+        buffer.append(text);
+    }
+    
+private:
+    ByteBuffer& buffer;
+};
+
+class BinaryReader {
+public:
+    BinaryReader(const char* data, size_t size) : cursor(data), end(data + size) {}
+    explicit BinaryReader(std::string_view bytes) : BinaryReader(bytes.data(), bytes.size()) {}
+    
+    uint64_t readVarint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            require(1);
+            auto byte = static_cast<unsigned char>(*cursor++);
+            // The tenth byte may only carry bit 63
+            if (shift == 63 && (byte & 0x7E) != 0) {
+                throw std::runtime_error("Varint overflows 64 bits");
+            }
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Malformed varint");
+    }
+    
+    int64_t readSigned() {
+        uint64_t raw = readVarint();
+        return static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+    }
+    
+    double readDouble() {
+        require(8);
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i) {
+            bits |= static_cast<uint64_t>(static_cast<unsigned char>(cursor[i])) << (8 * i);
+        }
+        cursor += 8;
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    
+    // Zero-copy: the view points into the reader's input.
+    std::string_view readString() {
+        uint64_t length = readVarint();
+        require(length);
+        std::string_view text(cursor, static_cast<size_t>(length));
+        cursor += length;
+        return text;
+    }
+    
+    bool atEnd() const noexcept { return cursor == end; }
+    size_t remaining() const noexcept { return static_cast<size_t>(end - cursor); }
+    
+private:
+    void require(uint64_t n) const {
+        if (n > static_cast<uint64_t>(end - cursor)) {
+            throw std::runtime_error("Unexpected end of serialized data");
+        }
+    }
+    
+    const char* cursor;
+    const char* end;
+};
+
+// Human-readable format, same shape as serialize(), built with std::to_chars
+// straight into the buffer instead of temporary strings.
+class TextWriter {
+public:
+    explicit TextWriter(ByteBuffer& buffer) : buffer(buffer) {}
+    
+    TextWriter& operator<<(std::string_view text) {
+        buffer.append(text);
+        return *this;
+    }
+    
+    TextWriter& operator<<(char c) {
+        buffer.push(c);
+        return *this;
+    }
+    
+    TextWriter& operator<<(int value) {
+        char* out = buffer.prepare(16);
+        auto result = std::to_chars(out, out + 16, value);
+        buffer.commit(static_cast<size_t>(result.ptr - out));
+        return *this;
+    }
+    
+    // Fixed notation with six decimals, matching std::to_string(double).
+    TextWriter& operator<<(double value) {
+        char* out = buffer.prepare(352);
+        auto result = std::to_chars(out, out + 352, value, std::chars_format::fixed, 6);
+        buffer.commit(static_cast<size_t>(result.ptr - out));
+        return *this;
+    }
+    
+private:
+    ByteBuffer& buffer;
+};
+
 // Type erasure for serializable objects
 class Serializable {
 public:
@@ -136,10 +355,23 @@ public:
         return pImpl->serialize();
     }
     
+    // Tagged binary record: type tag followed by the object's payload
+    void serializeBinary(BinaryWriter& writer) const {
+        writer.writeVarint(pImpl->typeTag());
+        pImpl->writeBinary(writer);
+    }
+    
+    void serializeText(TextWriter& writer) const {
+        pImpl->writeText(writer);
+    }
+    
 private:
     struct SerializableConcept {
         virtual ~SerializableConcept() = default;
         virtual std::string serialize() const = 0;
+        virtual uint32_t typeTag() const = 0;
+        virtual void writeBinary(BinaryWriter& writer) const = 0;
+        virtual void writeText(TextWriter& writer) const = 0;
     };
     
     template<typename T>
@@ -150,6 +382,18 @@ private:
             return object.serialize();
         }
         
+        uint32_t typeTag() const override {
+            return T::typeTag;
+        }
+        
+        void writeBinary(BinaryWriter& writer) const override {
+            object.writeBinary(writer);
+        }
+        
+        void writeText(TextWriter& writer) const override {
+            object.writeText(writer);
+        }
+        
         T object;
     };
     
@@ -159,12 +403,32 @@ private:
 // Concrete serializable types
 class User {
 public:
+    static constexpr uint32_t typeTag = 1;
+    
     User(const std::string& name, int age) : name(name), age(age) {}
     
     std::string serialize() const {
         return "User{name='" + name + "', age=" + std::to_string(age) + "}";
     }
     
+    void writeBinary(BinaryWriter& writer) const {
+        writer.writeString(name);
+        writer.writeSigned(age);
+    }
+    
+    void writeText(TextWriter& writer) const {
+        writer << "User{name='" << name << "', age=" << age << '}';
+    }
+    
+    static User readBinary(BinaryReader& reader) {
+        std::string name(reader.readString());
+        int64_t age = reader.readSigned();
+        if (age < std::numeric_limits<int>::min() || age > std::numeric_limits<int>::max()) {
+            throw std::runtime_error("Serialized age out of range");
+        }
+        return User(name, static_cast<int>(age));
+    }
+    
 private:
     std::string name;
     int age;
@@ -172,17 +436,87 @@ private:
 
 class Product {
 public:
+    static constexpr uint32_t typeTag = 2;
+    
     Product(const std::string& name, double price) : name(name), price(price) {}
     
     std::string serialize() const {
         return "Product{name='" + name + "', price=" + std::to_string(price) + "}";
     }
     
+    void writeBinary(BinaryWriter& writer) const {
+        writer.writeString(name);
+        writer.writeDouble(price);
+    }
+    
+    void writeText(TextWriter& writer) const {
+        writer << "Product{name='" << name << "', price=" << price << '}';
+    }
+    
+    static Product readBinary(BinaryReader& reader) {
+        std::string name(reader.readString());
+        double price = reader.readDouble();
+        return Product(name, price);
+    }
+    
 private:
     std::string name;
     double price;
 };
 
+// Maps binary type tags back to concrete types for deserialization
+class SerializerRegistry {
+public:
+    using Factory = Serializable (*)(BinaryReader&);
+    
+    template<typename T>
+    void registerType() {
+        factories[T::typeTag] = [](BinaryReader& reader) {
+            return Serializable(T::readBinary(reader));
+        };
+    }
+    
+    Serializable read(BinaryReader& reader) const {
+        auto tag = static_cast<uint32_t>(reader.readVarint());
+        auto it = factories.find(tag);
+        if (it == factories.end()) {
+            throw std::runtime_error("Unknown serialized type tag: " + std::to_string(tag));
+        }
+        return it->second(reader);
+    }
+    
+private:
+    std::unordered_map<uint32_t, Factory> factories;
+};
+
+// Batch serialization: element count followed by tagged records
+void serializeBatch(const std::vector<Serializable>& objects, ByteBuffer& buffer) {
+    BinaryWriter writer(buffer);
+    writer.writeVarint(objects.size());
+    for (const auto& object : objects) {
+        object.serializeBinary(writer);
+    }
+}
+
+void serializeBatchText(const std::vector<Serializable>& objects, ByteBuffer& buffer) {
+    TextWriter writer(buffer);
+    for (const auto& object : objects) {
+        object.serializeText(writer);
+        writer << '\n';
+    }
+}
+
+std::vector<Serializable> deserializeBatch(BinaryReader& reader, const SerializerRegistry& registry) {
+    auto count = reader.readVarint();
+    std::vector<Serializable> objects;
+    // Every record takes at least one byte, so never trust count beyond that
+    objects.reserve(static_cast<size_t>(std::min<uint64_t>(count, reader.remaining())));
+    for (uint64_t i = 0; i < count; ++i) {
+        objects.push_back(registry.read(reader));
+    }
+    return objects;
+}
+
 int main() {
     std::cout << "=== Type Erasure Pattern Example ===" << std::endl;
     
@@ -228,6 +562,83 @@ int main() {
     std::cout << "Serialized: " << user.serialize() << std::endl;
     std::cout << "Serialized: " << product.serialize() << std::endl;
     
+    // Buffer-based serialization
+    std::cout << "\n--- Binary and Text Serialization ---" << std::endl;
+    
+    SerializerRegistry registry;
+    registry.registerType<User>();
+    registry.registerType<Product>();
+    
+    std::vector<Serializable> batch;
+    batch.push_back(User("John Doe", 30));
+    batch.push_back(Product("Laptop", 999.99));
+    batch.push_back(User("Jane Roe", 27));
+    
+    ByteBuffer textBuffer;
+    serializeBatchText(batch, textBuffer);
+    std::cout << "Text batch:\n" << textBuffer.view();
+    
+    ByteBuffer binaryBuffer;
+    serializeBatch(batch, binaryBuffer);
+    std::cout << "Binary batch: " << binaryBuffer.size() << " bytes (text: "
+              << textBuffer.size() << " bytes)" << std::endl;
+    
+    BinaryReader reader(binaryBuffer.view());
+    auto restored = deserializeBatch(reader, registry);
+    for (const auto& object : restored) {
+        std::cout << "Restored: " << object.serialize() << std::endl;
+    }
+    
+    // Throughput benchmark
+    std::cout << "\n--- Serialization Throughput (MB/s) ---" << std::endl;
+    {
+        std::vector<Serializable> objects;
+        const size_t count = 200000;
+        objects.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            if (i % 2 == 0) {
+                objects.push_back(User("user-" + std::to_string(i), static_cast<int>(i % 90)));
+            } else {
+                objects.push_back(Product("product-" + std::to_string(i), static_cast<double>(i) * 0.25));
+            }
+        }
+        
+        auto report = [](const char* label, size_t bytes, auto start, auto end) {
+            double seconds = std::chrono::duration<double>(end - start).count();
+            std::cout << label << ": " << bytes << " bytes, "
+                      << (static_cast<double>(bytes) / (1024.0 * 1024.0)) / seconds << " MB/s" << std::endl;
+        };
+        
+        auto start = std::chrono::steady_clock::now();
+        std::string concatenated;
+        for (const auto& object : objects) {
+            concatenated += object.serialize();
+            concatenated += '\n';
+        }
+        auto end = std::chrono::steady_clock::now();
+        report("String concat (serialize())", concatenated.size(), start, end);
+        
+        ByteBuffer buffer(1 << 20);
+        start = std::chrono::steady_clock::now();
+        serializeBatchText(objects, buffer);
+        end = std::chrono::steady_clock::now();
+        report("Text (to_chars into buffer)", buffer.size(), start, end);
+        std::cout << "Text output identical: " << (buffer.view() == concatenated ? "yes" : "no") << std::endl;
+        
+        buffer.clear();
+        start = std::chrono::steady_clock::now();
+        serializeBatch(objects, buffer);
+        end = std::chrono::steady_clock::now();
+        report("Binary (varint)", buffer.size(), start, end);
+        
+        start = std::chrono::steady_clock::now();
+        BinaryReader batchReader(buffer.view());
+        auto decoded = deserializeBatch(batchReader, registry);
+        end = std::chrono::steady_clock::now();
+        report("Binary decode", buffer.size(), start, end);
+        std::cout << "Decoded objects: " << decoded.size() << std::endl;
+    }
+    
     // Moving type-erased objects
     std::cout << "\n--- Moving ---" << std::endl;
     
@@ -5,6 +5,18 @@
 #include <functional>
 #include <type_traits>
 #include <any>
+#include <variant>
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <typeinfo>
+#include <tuple>
+#include <array>
+#include <string_view>
+#include <random>
+
+#include "callable.hpp"
 
 // Optimized Type Erasure Pattern Example
 // Using modern C++17/20 features for better performance and type safety
@@ -220,6 +232,242 @@ private:
     std::any data_;
 };
 
+// Per-type identity without RTTI: every T gets its own static tag object, and
+// the tag's address serves as a unique pointer-sized id. The address is a
+// runtime value (not a constant expression across translation units), but
+// comparing two ids is a single integer compare with no std::type_info.
+using TypeId = const void*;
+
+template<typename T>
+struct TypeIdTag {
+    static constexpr char tag = 0;
+};
+
+template<typename T>
+[[nodiscard]] constexpr TypeId typeIdOf() noexcept {
+    return &TypeIdTag<std::remove_cv_t<std::remove_reference_t<T>>>::tag;
+}
+
+// Typed any with a guaranteed inline buffer of Capacity bytes.
+// Values that fit (and are nothrow-movable) never touch the heap; larger ones
+// fall back to a single heap allocation. Copyable = false gives a move-only
+// variant that also accepts move-only payloads (unique_ptr, file handles...).
+template<std::size_t Capacity, bool Copyable>
+class BasicSmallAny {
+    static_assert(Capacity >= sizeof(void*), "Capacity must hold at least a pointer");
+
+    // Small buffers only need pointer alignment, which keeps a pointer-sized
+    // BasicSmallAny as compact as std::any itself.
+    static constexpr std::size_t bufferAlign =
+        Capacity >= alignof(std::max_align_t) ? alignof(std::max_align_t) : alignof(void*);
+
+    union Storage {
+        alignas(bufferAlign) unsigned char buffer[Capacity];
+        void* heap;
+    };
+
+    struct Ops {
+        TypeId type;
+        void (*destroy)(Storage&) noexcept;
+        void (*move)(Storage& dst, Storage& src) noexcept;
+        void (*copy)(Storage& dst, const Storage& src);
+        const char* (*name)() noexcept;
+    };
+
+    // Copy operations take this instead of BasicSmallAny when Copyable is
+    // false, so they are not copy constructors/assignments at all and the
+    // implicit ones are deleted (the class declares move operations).
+    struct CopyDisabled;
+    using CopySource = std::conditional_t<Copyable, BasicSmallAny, CopyDisabled>;
+
+public:
+    template<typename T>
+    static constexpr bool fitsInline =
+        sizeof(T) <= Capacity &&
+        alignof(T) <= bufferAlign &&
+        std::is_nothrow_move_constructible_v<T>;
+
+    static constexpr std::size_t inlineCapacity = Capacity;
+
+    BasicSmallAny() noexcept = default;
+
+    // Only participates for payloads this variant can hold, so
+    // is_constructible reports move-only types as unsupported by SmallAny
+    template<typename T, typename D = std::decay_t<T>,
+             typename = std::enable_if_t<!std::is_same_v<D, BasicSmallAny> &&
+                                         (!Copyable || std::is_copy_constructible_v<D>)>>
+    BasicSmallAny(T&& value) {
+        emplace<D>(std::forward<T>(value));
+    }
+
+    ~BasicSmallAny() {
+        reset();
+    }
+
+    BasicSmallAny(const CopySource& other) {
+        if (other.ops_) {
+            other.ops_->copy(storage_, other.storage_);
+            ops_ = other.ops_;
+        }
+    }
+
+    BasicSmallAny& operator=(const CopySource& other) {
+        if (this != &other) {
+            BasicSmallAny copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    BasicSmallAny(BasicSmallAny&& other) noexcept {
+        moveFrom(other);
+    }
+
+    BasicSmallAny& operator=(BasicSmallAny&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    template<typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        static_assert(!Copyable || std::is_copy_constructible_v<T>,
+                      "Copyable BasicSmallAny requires a copy-constructible type");
+        reset();
+        T* object;
+        if constexpr (fitsInline<T>) {
+            object = ::new (static_cast<void*>(storage_.buffer)) T(std::forward<Args>(args)...);
+        } else {
+            object = new T(std::forward<Args>(args)...);
+            storage_.heap = object;
+        }
+        ops_ = &OpsFor<T>::table;
+        return *object;
+    }
+
+    // One pointer compare against the per-type ops table; the inline/heap
+    // decision is resolved at compile time. get<const T>() finds a stored T.
+    template<typename T>
+    [[nodiscard]] T* get() noexcept {
+        using D = std::decay_t<T>;
+        if (ops_ != &OpsFor<D>::table) {
+            return nullptr;
+        }
+        return OpsFor<D>::ptr(storage_);
+    }
+
+    template<typename T>
+    [[nodiscard]] const T* get() const noexcept {
+        using D = std::decay_t<T>;
+        if (ops_ != &OpsFor<D>::table) {
+            return nullptr;
+        }
+        return OpsFor<D>::ptr(const_cast<Storage&>(storage_));
+    }
+
+    template<typename T>
+    [[nodiscard]] std::decay_t<T> getValue() const {
+        if (const auto* value = get<T>()) {
+            return *value;
+        }
+        throw std::bad_any_cast();
+    }
+
+    template<typename T>
+    [[nodiscard]] bool holds() const noexcept {
+        return ops_ == &OpsFor<std::decay_t<T>>::table;
+    }
+
+    [[nodiscard]] bool hasValue() const noexcept {
+        return ops_ != nullptr;
+    }
+
+    [[nodiscard]] TypeId typeId() const noexcept {
+        return ops_ ? ops_->type : nullptr;
+    }
+
+    [[nodiscard]] const char* typeName() const noexcept {
+        return ops_ ? ops_->name() : "empty";
+    }
+
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    template<typename T>
+    struct OpsFor {
+        static T* ptr(Storage& s) noexcept {
+            if constexpr (fitsInline<T>) {
+                return std::launder(reinterpret_cast<T*>(s.buffer));
+            } else {
+                return static_cast<T*>(s.heap);
+            }
+        }
+
+        static void destroy(Storage& s) noexcept {
+            if constexpr (fitsInline<T>) {
+                ptr(s)->~T();
+            } else {
+                delete ptr(s);
+            }
+        }
+
+        static void move(Storage& dst, Storage& src) noexcept {
+            if constexpr (fitsInline<T>) {
+                ::new (static_cast<void*>(dst.buffer)) T(std::move(*ptr(src)));
+                ptr(src)->~T();
+            } else {
+                dst.heap = src.heap;
+                src.heap = nullptr;
+            }
+        }
+
+        static void copy(Storage& dst, const Storage& src) {
+            if constexpr (Copyable) {
+                const T& value = *ptr(const_cast<Storage&>(src));
+                if constexpr (fitsInline<T>) {
+                    ::new (static_cast<void*>(dst.buffer)) T(value);
+                } else {
+                    dst.heap = new T(value);
+                }
+            } else {
+                (void)dst;
+                (void)src;
+            }
+        }
+
+        static const char* name() noexcept {
+            return typeid(T).name();
+        }
+
+        static constexpr Ops table{typeIdOf<T>(), &destroy, &move, &copy, &name};
+    };
+
+    void moveFrom(BasicSmallAny& other) noexcept {
+        if (other.ops_) {
+            other.ops_->move(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    Storage storage_;
+    const Ops* ops_ = nullptr;
+};
+
+// 32 bytes inline covers scalars, std::string on all major ABIs and the small
+// erased types in this file.
+using SmallAny = BasicSmallAny<32, true>;
+using UniqueSmallAny = BasicSmallAny<32, false>;
+// Pointer-sized buffer for scalar-heavy maps (counters, flags, ids).
+using CompactAny = BasicSmallAny<sizeof(void*), true>;
+
 // Type erasure with virtual interface
 class IOperation {
 public:
@@ -370,15 +618,154 @@ public:
         return std::visit([value](const auto& obj) { return obj.calculate(value); }, data_);
     }
     
-    [[nodiscard]] std::string getTypeName() const {
-        return std::visit([](const auto& obj) { return typeid(obj).name(); }, data_);
+    // Table lookup by alternative index: no visit, typeid or string copy per call
+    [[nodiscard]] std::string_view getTypeName() const noexcept {
+        return typeNames_[data_.index()];
     }
 
 private:
+    template<typename... Ts>
+    static std::array<const char*, sizeof...(Ts)> namesOf(const std::variant<Ts...>*) {
+        return {typeid(Ts).name()...};
+    }
+    
+    inline static const auto typeNames_ = namesOf(static_cast<const VariantEraser*>(nullptr));
+    
     VariantEraser data_;
 };
 
+// Partitioned variant collection
+// Instead of one std::variant per element and a std::visit per call, each
+// alternative gets its own contiguous array. Dispatch happens once at insert
+// time; each loop below then calls one concrete calculate(), which inlines.
+// sumAll streams each partition contiguously. calculateAll keeps insertion
+// order, so it gathers inputs and scatters outputs through positions[i]:
+// the call inlines, but the indexed accesses generally prevent vectorizing.
+template<typename... Ts>
+class VariantCollection {
+public:
+    using value_type = std::variant<Ts...>;
+    
+    void add(const value_type& value) {
+        std::visit([this](const auto& obj) { push(obj); }, value);
+    }
+    
+    template<typename T, typename = std::enable_if_t<(std::is_same_v<T, Ts> || ...)>>
+    void add(T value) {
+        push(std::move(value));
+    }
+    
+    // Exact per-type capacity
+    template<typename T>
+    void reserve(size_t count) {
+        auto& partition = std::get<Partition<T>>(partitions_);
+        partition.objects.reserve(count);
+        partition.positions.reserve(count);
+    }
+    
+    // Total capacity split evenly across the types (assumes a balanced mix)
+    void reserve(size_t capacity) {
+        const size_t share = (capacity + sizeof...(Ts) - 1) / sizeof...(Ts);
+        (reserve<Ts>(share), ...);
+    }
+    
+    // outputs[i] = element_i.calculate(inputs[i]), i in insertion order
+    void calculateAll(const int* inputs, int* outputs) const {
+        std::apply([inputs, outputs](const auto&... partitions) {
+            (runPartition(partitions, inputs, outputs), ...);
+        }, partitions_);
+    }
+    
+    // Applies one input to every element and sums the results
+    [[nodiscard]] long long sumAll(int input) const {
+        long long total = 0;
+        std::apply([input, &total](const auto&... partitions) {
+            ((total += sumPartition(partitions, input)), ...);
+        }, partitions_);
+        return total;
+    }
+    
+    template<typename T>
+    [[nodiscard]] const std::vector<T>& partition() const {
+        return std::get<Partition<T>>(partitions_).objects;
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return size_;
+    }
+    
+    void clear() {
+        std::apply([](auto&... partitions) {
+            (partitions.objects.clear(), ...);
+            (partitions.positions.clear(), ...);
+        }, partitions_);
+        size_ = 0;
+    }
+
+private:
+    template<typename T>
+    struct Partition {
+        std::vector<T> objects;
+        std::vector<size_t> positions;  // insertion index of each object
+    };
+    
+    template<typename T>
+    void push(T value) {
+        auto& partition = std::get<Partition<T>>(partitions_);
+        partition.objects.push_back(std::move(value));
+        partition.positions.push_back(size_++);
+    }
+    
+    template<typename T>
+    static void runPartition(const Partition<T>& partition, const int* inputs, int* outputs) {
+        const T* objects = partition.objects.data();
+        const size_t* positions = partition.positions.data();
+        const size_t count = partition.objects.size();
+        for (size_t i = 0; i < count; ++i) {
+            const size_t position = positions[i];
+            outputs[position] = objects[i].calculate(inputs[position]);
+        }
+    }
+    
+    template<typename T>
+    static long long sumPartition(const Partition<T>& partition, int input) {
+        long long total = 0;
+        for (const T& object : partition.objects) {
+            total += object.calculate(input);
+        }
+        return total;
+    }
+    
+    std::tuple<Partition<Ts>...> partitions_;
+    size_t size_ = 0;
+};
+
+using CalculatorCollection = VariantCollection<Calculator, Adder, Multiplier>;
+
+// Classic virtual-dispatch equivalent, used as a benchmark baseline
+class ICalculable {
+public:
+    virtual ~ICalculable() = default;
+    [[nodiscard]] virtual int calculate(int value) const = 0;
+};
+
+template<typename T>
+class CalculableModel : public ICalculable {
+public:
+    explicit CalculableModel(T object) : object_(std::move(object)) {}
+    
+    [[nodiscard]] int calculate(int value) const override {
+        return object_.calculate(value);
+    }
+
+private:
+    T object_;
+};
+
 // Modern type erasure with function objects
+// Uses InplaceFunction from callable.hpp: same shape as std::function, but the
+// captured object always lives in an inline buffer, so construction never
+// allocates.
 class FunctionTypeEraser {
 public:
     template<typename T>
@@ -400,9 +787,9 @@ public:
     }
 
 private:
-    std::function<void()> printFunc_;
-    std::function<int(int)> calculateFunc_;
-    std::function<std::string()> typeFunc_;
+    InplaceFunction<void()> printFunc_;
+    InplaceFunction<int(int)> calculateFunc_;
+    InplaceFunction<std::string()> typeFunc_;
 };
 
 int main() {
@@ -440,6 +827,107 @@ int main() {
         std::cout << "Any eraser result: " << calc->calculate(6) << std::endl;
     }
     
+    // Small-buffer typed any
+    std::cout << "\n--- SmallAny (Inline Storage, Integer Type Id) ---" << std::endl;
+    
+    SmallAny smallAny{Adder(9)};
+    if (auto* adder = smallAny.get<Adder>()) {
+        adder->print();
+        std::cout << "SmallAny result: " << adder->calculate(6) << std::endl;
+    }
+    std::cout << "Holds Calculator? " << (smallAny.holds<Calculator>() ? "yes" : "no") << std::endl;
+    std::cout << "std::string stored inline? "
+              << (SmallAny::fitsInline<std::string> ? "yes" : "no") << std::endl;
+    
+    SmallAny copiedAny = smallAny;
+    std::cout << "Copied value: " << copiedAny.getValue<Adder>().calculate(1) << std::endl;
+    
+    UniqueSmallAny uniqueAny{std::make_unique<Multiplier>(7)};
+    UniqueSmallAny movedAny = std::move(uniqueAny);
+    if (auto* owned = movedAny.get<std::unique_ptr<Multiplier>>()) {
+        std::cout << "Move-only payload result: " << (*owned)->calculate(3) << std::endl;
+    }
+    std::cout << "Source empty after move? " << (!uniqueAny.hasValue() ? "yes" : "no") << std::endl;
+    
+    // Read-path benchmark: typed lookups over a large collection of erased values
+    std::cout << "\n--- SmallAny vs std::any Read Benchmark ---" << std::endl;
+    {
+        constexpr std::size_t count = 1'000'000;
+        std::vector<AnyTypeEraser> anyValues;
+        std::vector<SmallAny> smallValues;
+        std::vector<CompactAny> compactValues;
+        anyValues.reserve(count);
+        smallValues.reserve(count);
+        compactValues.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i % 4 == 0) {
+                anyValues.emplace_back(static_cast<double>(i));
+                smallValues.emplace_back(static_cast<double>(i));
+                compactValues.emplace_back(static_cast<double>(i));
+            } else {
+                anyValues.emplace_back(static_cast<int>(i));
+                smallValues.emplace_back(static_cast<int>(i));
+                compactValues.emplace_back(static_cast<int>(i));
+            }
+        }
+        
+        auto measure = [](const char* label, auto&& body) {
+            auto start = std::chrono::steady_clock::now();
+            long long checksum = body();
+            auto end = std::chrono::steady_clock::now();
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            std::cout << label << ": " << static_cast<double>(ns) / count << " ns/lookup"
+                      << " (checksum " << checksum << ")" << std::endl;
+        };
+        
+        measure("std::any   get<int>", [&] {
+            long long sum = 0;
+            for (const auto& value : anyValues) {
+                if (const int* v = value.get<int>()) sum += *v;
+            }
+            return sum;
+        });
+        measure("SmallAny   get<int>", [&] {
+            long long sum = 0;
+            for (const auto& value : smallValues) {
+                if (const int* v = value.get<int>()) sum += *v;
+            }
+            return sum;
+        });
+        measure("CompactAny get<int>", [&] {
+            long long sum = 0;
+            for (const auto& value : compactValues) {
+                if (const int* v = value.get<int>()) sum += *v;
+            }
+            return sum;
+        });
+        
+        // Config-style values: std::any heap-allocates strings, SmallAny keeps them inline
+        std::vector<AnyTypeEraser> anyStrings;
+        std::vector<SmallAny> smallStrings;
+        anyStrings.reserve(count);
+        smallStrings.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string value = "value-" + std::to_string(i % 1000);
+            anyStrings.emplace_back(value);
+            smallStrings.emplace_back(std::move(value));
+        }
+        measure("std::any   get<std::string>", [&] {
+            long long sum = 0;
+            for (const auto& value : anyStrings) {
+                if (const auto* v = value.get<std::string>()) sum += static_cast<long long>(v->size());
+            }
+            return sum;
+        });
+        measure("SmallAny   get<std::string>", [&] {
+            long long sum = 0;
+            for (const auto& value : smallStrings) {
+                if (const auto* v = value.get<std::string>()) sum += static_cast<long long>(v->size());
+            }
+            return sum;
+        });
+    }
+    
     // Virtual interface type erasure
     std::cout << "\n--- Virtual Interface Type Erasure Example ---" << std::endl;
     
@@ -457,6 +945,7 @@ int main() {
     VariantTypeEraser variantEraser(Calculator(6));
     variantEraser.print();
     std::cout << "Variant result: " << variantEraser.calculate(8) << std::endl;
+    std::cout << "Variant type: " << variantEraser.getTypeName() << std::endl;
     
     // Function-based type erasure
     std::cout << "\n--- Function-based Type Erasure Example ---" << std::endl;
@@ -465,6 +954,166 @@ int main() {
     funcEraser.print();
     std::cout << "Function result: " << funcEraser.calculate(5) << std::endl;
     
+    // Partitioned variant collection
+    std::cout << "\n--- Partitioned Variant Collection ---" << std::endl;
+    
+    CalculatorCollection collection;
+    collection.add(VariantEraser{Adder(1)});
+    collection.add(Calculator(2));
+    collection.add(Multiplier(3));
+    collection.add(Adder(4));
+    
+    std::vector<int> batchInputs{10, 20, 30, 40};
+    std::vector<int> batchOutputs(batchInputs.size());
+    collection.calculateAll(batchInputs.data(), batchOutputs.data());
+    for (size_t i = 0; i < batchOutputs.size(); ++i) {
+        std::cout << "Element " << i << ": " << batchInputs[i] << " -> " << batchOutputs[i] << std::endl;
+    }
+    std::cout << "Adders stored contiguously: " << collection.partition<Adder>().size() << std::endl;
+    
+    // Dispatch benchmark over a large mixed collection
+    std::cout << "\n--- Dispatch Benchmark (1M mixed elements) ---" << std::endl;
+    {
+        constexpr size_t count = 1'000'000;
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> pick(0, 2);
+        std::uniform_int_distribution<int> param(1, 9);
+        
+        std::vector<VariantTypeEraser> variants;
+        std::vector<FunctionTypeEraser> functions;
+        std::vector<std::unique_ptr<ICalculable>> virtuals;
+        CalculatorCollection partitioned;
+        variants.reserve(count);
+        functions.reserve(count);
+        virtuals.reserve(count);
+        partitioned.reserve(count);
+        
+        for (size_t i = 0; i < count; ++i) {
+            int p = param(rng);
+            switch (pick(rng)) {
+            case 0:
+                variants.emplace_back(Calculator(p));
+                functions.emplace_back(Calculator(p));
+                virtuals.push_back(std::make_unique<CalculableModel<Calculator>>(Calculator(p)));
+                partitioned.add(Calculator(p));
+                break;
+            case 1:
+                variants.emplace_back(Adder(p));
+                functions.emplace_back(Adder(p));
+                virtuals.push_back(std::make_unique<CalculableModel<Adder>>(Adder(p)));
+                partitioned.add(Adder(p));
+                break;
+            default:
+                variants.emplace_back(Multiplier(p));
+                functions.emplace_back(Multiplier(p));
+                virtuals.push_back(std::make_unique<CalculableModel<Multiplier>>(Multiplier(p)));
+                partitioned.add(Multiplier(p));
+                break;
+            }
+        }
+        
+        std::vector<int> inputs(count);
+        for (size_t i = 0; i < count; ++i) {
+            inputs[i] = static_cast<int>(i % 100);
+        }
+        std::vector<int> outputs(count);
+        
+        auto measure = [&](const char* label, auto&& body) {
+            auto start = std::chrono::steady_clock::now();
+            body();
+            auto end = std::chrono::steady_clock::now();
+            long long checksum = 0;
+            for (int value : outputs) checksum += value;
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            std::cout << label << ": " << static_cast<double>(ns) / count << " ns/element"
+                      << " (checksum " << checksum << ")" << std::endl;
+        };
+        
+        measure("std::visit per element  ", [&] {
+            for (size_t i = 0; i < count; ++i) outputs[i] = variants[i].calculate(inputs[i]);
+        });
+        measure("FunctionTypeEraser      ", [&] {
+            for (size_t i = 0; i < count; ++i) outputs[i] = functions[i].calculate(inputs[i]);
+        });
+        measure("Virtual interface       ", [&] {
+            for (size_t i = 0; i < count; ++i) outputs[i] = virtuals[i]->calculate(inputs[i]);
+        });
+        measure("Partitioned collection  ", [&] {
+            partitioned.calculateAll(inputs.data(), outputs.data());
+        });
+    }
+    
+    // Callable toolkit benchmark
+    std::cout << "\n--- std::function vs InplaceFunction vs FunctionRef ---" << std::endl;
+    {
+        constexpr int iterations = 2'000'000;
+        std::vector<int> offsets(iterations);
+        for (int i = 0; i < iterations; ++i) {
+            offsets[i] = i % 64;
+        }
+        
+        auto measure = [](const char* label, auto&& body) {
+            auto start = std::chrono::steady_clock::now();
+            long long checksum = body();
+            auto end = std::chrono::steady_clock::now();
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            std::cout << label << ": " << static_cast<double>(ns) / iterations << " ns/op"
+                      << " (checksum " << checksum << ")" << std::endl;
+        };
+        
+        // Construction: a capture just larger than std::function's small buffer
+        measure("Construct std::function  ", [&] {
+            long long sum = 0;
+            for (int i = 0; i < iterations; ++i) {
+                long long a = offsets[i], b = i, c = 3;
+                std::function<long long(int)> f = [a, b, c](int x) { return a + b + c + x; };
+                sum += f(1);
+            }
+            return sum;
+        });
+        measure("Construct InplaceFunction", [&] {
+            long long sum = 0;
+            for (int i = 0; i < iterations; ++i) {
+                long long a = offsets[i], b = i, c = 3;
+                InplaceFunction<long long(int)> f = [a, b, c](int x) { return a + b + c + x; };
+                sum += f(1);
+            }
+            return sum;
+        });
+        measure("Construct FunctionRef    ", [&] {
+            long long sum = 0;
+            for (int i = 0; i < iterations; ++i) {
+                long long a = offsets[i], b = i, c = 3;
+                auto lambda = [a, b, c](int x) { return a + b + c + x; };
+                FunctionRef<long long(int)> f = lambda;
+                sum += f(1);
+            }
+            return sum;
+        });
+        
+        // Call: the same stored callable invoked repeatedly
+        int factor = 3;
+        auto body = [factor](int x) { return x * factor; };
+        std::function<int(int)> stdFunc = body;
+        InplaceFunction<int(int)> inplaceFunc = body;
+        FunctionRef<int(int)> refFunc = body;
+        measure("Call std::function       ", [&] {
+            long long sum = 0;
+            for (int x : offsets) sum += stdFunc(x);
+            return sum;
+        });
+        measure("Call InplaceFunction     ", [&] {
+            long long sum = 0;
+            for (int x : offsets) sum += inplaceFunc(x);
+            return sum;
+        });
+        measure("Call FunctionRef         ", [&] {
+            long long sum = 0;
+            for (int x : offsets) sum += refFunc(x);
+            return sum;
+        });
+    }
+    
     // Demonstrate type safety and cloning
     std::cout << "\n--- Type Safety and Cloning Demo ---" << std::endl;
     
@@ -4,7 +4,42 @@
 #include <memory>
 #include <functional>
 #include <type_traits>
+#include <typeinfo>
 #include <map>
+#include <algorithm>
+#include <string_view>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <optional>
+#include <unordered_map>
+#include <filesystem>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include <condition_variable>
+#include <initializer_list>
+#include <charconv>
+#include <fstream>
+#include <cmath>
+
+#include "counting_resource.hpp"
+#include "flat_map.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define YAGNI_HAS_POSIX_IO 1
+#else
+#define YAGNI_HAS_POSIX_IO 0
+#endif
 
 // Optimized YAGNI (You Aren't Gonna Need It) Principle Example
 // Using modern C++17/20 features for better performance and maintainability
@@ -179,32 +214,1018 @@ private:
     std::vector<std::unique_ptr<SimpleUser>> users_;
 };
 
+// Hash-indexed user manager for the session-lookup hot path
+// Users live by value in a HashFlatMap keyed by email: one contiguous entry
+// vector, so forEachUser is a dense loop and there is no per-user allocation
+// beyond the strings themselves, plus a linear-probing index for O(1) lookup.
+// Removal swaps the last user into the hole (no tombstones).
+// Pointers returned by findUser are invalidated by the next add or remove.
+class IndexedUserManager {
+public:
+    bool addUser(SimpleUser user) {
+        if (!user.isValid()) {
+            return false;
+        }
+        const std::string& email = user.getEmail();
+        const uint64_t hash = HashFlatMap<SimpleUser>::hashOf(email);
+        if (users_.find(email, hash)) {
+            return false;
+        }
+        // Safe to pass a view of user's own email: the map copies the key
+        // before it moves the value in
+        return users_.insertOrAssign(email, hash, std::move(user));
+    }
+    
+    bool emplaceUser(std::string name, std::string email) {
+        return addUser(SimpleUser(std::move(name), std::move(email)));
+    }
+    
+    bool removeUser(std::string_view email) {
+        return users_.erase(email);
+    }
+    
+    [[nodiscard]] const SimpleUser* findUser(std::string_view email) const {
+        return users_.find(email);
+    }
+    
+    [[nodiscard]] size_t getUserCount() const noexcept {
+        return users_.size();
+    }
+    
+    void reserve(size_t count) {
+        users_.reserve(count);
+    }
+    
+    // Dense iteration; order changes when users are removed
+    template<typename Func>
+    void forEachUser(Func func) const {
+        users_.forEach([&func](std::string_view, const SimpleUser& user) { func(user); });
+    }
+
+private:
+    HashFlatMap<SimpleUser> users_;
+};
+
 // Simple data storage with only current requirements
+// Keys are looked up as string_view; the backing map is chosen at
+// construction (std::map by default, flat maps for hot tables).
 class SimpleDataStore {
 public:
+    explicit SimpleDataStore(StringMapKind kind = StringMapKind::Tree,
+                             std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : data_(kind, resource) {}
+    
     // Only store what we need now
-    void save(const std::string& key, const std::string& value) {
-        data_[key] = value;
+    void save(std::string_view key, std::string value) {
         std::cout << "Saved: " << key << " = " << value << std::endl;
+        data_.insertOrAssign(key, std::move(value));
+    }
+    
+    [[nodiscard]] std::string load(std::string_view key) const {
+        const std::string* value = data_.find(key);
+        return value ? *value : "";
     }
     
-    [[nodiscard]] std::string load(const std::string& key) const {
-        auto it = data_.find(key);
-        return it != data_.end() ? it->second : "";
+    // No-copy lookup; the pointer is valid until the next save or remove
+    [[nodiscard]] const std::string* find(std::string_view key) const {
+        return data_.find(key);
     }
     
-    void remove(const std::string& key) {
-        if (data_.erase(key) > 0) {
+    void remove(std::string_view key) {
+        if (data_.erase(key)) {
             std::cout << "Removed: " << key << std::endl;
         }
     }
     
-    [[nodiscard]] bool exists(const std::string& key) const {
-        return data_.find(key) != data_.end();
+    [[nodiscard]] bool exists(std::string_view key) const {
+        return data_.find(key) != nullptr;
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return data_.size();
+    }
+
+private:
+    StringMap<std::string> data_;
+};
+
+// Log-structured key-value engine grown from SimpleDataStore
+// - writes go to an append-only write-ahead log, then a hash memtable
+// - a full memtable is written out as an immutable segment file: records in
+//   key order, a sparse index (every indexInterval-th key) and a bloom filter
+// - segments are memory-mapped, so load() returns views straight into the
+//   mapping (or the memtable) without copying
+// - once compactionTrigger segments exist, a background thread merges them
+//   into one, dropping overwritten values and tombstones; the foreground
+//   installs the result at its next write, so a view from load() stays valid
+//   until the next non-const call on the store
+// - snapshot() pins the current segment set; its views outlive later writes
+// Not thread-safe: one thread drives the store, compaction runs beside it.
+// File formats use host byte order.
+namespace kv_detail {
+
+constexpr uint32_t kTombstone = UINT32_MAX;
+constexpr uint32_t kSegmentMagic = 0x4B565347; // "KVSG"
+constexpr uint8_t kWalPut = 1;
+constexpr uint8_t kWalRemove = 2;
+
+inline uint64_t fnv1a(std::string_view bytes) noexcept {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : bytes) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline uint64_t mix(uint64_t x) noexcept {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    return x ^ (x >> 33);
+}
+
+// Makes a rename or create inside directory durable
+inline void syncDirectory(const std::filesystem::path& directory) {
+#if YAGNI_HAS_POSIX_IO
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + directory.string());
+    }
+    const bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    if (!ok) {
+        throw std::runtime_error("Cannot sync " + directory.string());
+    }
+#else
+    (void)directory;
+#endif
+}
+
+template<typename T>
+void appendPod(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+T readPod(const char* at) noexcept {
+    T value;
+    std::memcpy(&value, at, sizeof(T));
+    return value;
+}
+
+// Double hashing: probe i is h1 + i * h2
+inline void bloomAdd(std::string& bits, uint32_t hashes, std::string_view key) {
+    const uint64_t numBits = bits.size() * 8;
+    const uint64_t h1 = mix(fnv1a(key));
+    const uint64_t h2 = mix(h1) | 1;
+    for (uint32_t i = 0; i < hashes; ++i) {
+        uint64_t bit = (h1 + i * h2) % numBits;
+        bits[bit / 8] = static_cast<char>(bits[bit / 8] | (1 << (bit % 8)));
+    }
+}
+
+inline bool bloomMayContain(std::string_view bits, uint32_t hashes, std::string_view key) noexcept {
+    const uint64_t numBits = bits.size() * 8;
+    const uint64_t h1 = mix(fnv1a(key));
+    const uint64_t h2 = mix(h1) | 1;
+    for (uint32_t i = 0; i < hashes; ++i) {
+        uint64_t bit = (h1 + i * h2) % numBits;
+        if (!(static_cast<unsigned char>(bits[bit / 8]) & (1 << (bit % 8)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Read-only view of a whole file; mmap where available, a heap copy otherwise
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path) {
+#if YAGNI_HAS_POSIX_IO
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open " + path.string());
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat " + path.string());
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0) {
+            void* base = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (base == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot map " + path.string());
+            }
+            base_ = static_cast<const char*>(base);
+        }
+        ::close(fd);
+#else
+        std::FILE* file = std::fopen(path.string().c_str(), "rb");
+        if (!file) {
+            throw std::runtime_error("Cannot open " + path.string());
+        }
+        buffer_.resize(static_cast<size_t>(std::filesystem::file_size(path)));
+        size_t read = std::fread(buffer_.data(), 1, buffer_.size(), file);
+        std::fclose(file);
+        buffer_.resize(read);
+#endif
+    }
+    
+    ~MappedFile() {
+#if YAGNI_HAS_POSIX_IO
+        if (base_) {
+            ::munmap(const_cast<char*>(base_), size_);
+        }
+#endif
+    }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    [[nodiscard]] std::string_view bytes() const noexcept {
+#if YAGNI_HAS_POSIX_IO
+        return {base_, size_};
+#else
+        return buffer_;
+#endif
+    }
+
+private:
+#if YAGNI_HAS_POSIX_IO
+    const char* base_ = nullptr;
+    size_t size_ = 0;
+#else
+    std::string buffer_;
+#endif
+};
+
+// Immutable sorted segment file
+//   records : [u32 keyLen][u32 valueLen | kTombstone][key][value] ...
+//   index   : [u32 count] then [u32 keyLen][key][u64 recordOffset] ...
+//   bloom   : [u32 hashes][u64 byteCount][bits]
+//   footer  : [u64 indexOffset][u64 bloomOffset][u64 records][u64 coversFrom][u32 magic]
+// coversFrom is the oldest sequence merged into this segment; after a crash
+// mid-compaction, older files inside that range are stale and get deleted.
+class Segment {
+public:
+    enum class Lookup { Absent, Value, Deleted };
+    
+    static constexpr size_t kFooterSize = 4 * sizeof(uint64_t) + sizeof(uint32_t);
+    
+    Segment(std::filesystem::path path, uint64_t sequence)
+        : path_(std::move(path)), sequence_(sequence), file_(path_) {
+        std::string_view bytes = file_.bytes();
+        if (bytes.size() < kFooterSize ||
+            readPod<uint32_t>(bytes.data() + bytes.size() - sizeof(uint32_t)) != kSegmentMagic) {
+            throw std::runtime_error("Corrupt segment " + path_.string());
+        }
+        // Every offset and length below comes from the file, so each is
+        // checked against the region it must fall in before it is used
+        auto require = [this](bool valid) {
+            if (!valid) {
+                throw std::runtime_error("Corrupt segment " + path_.string());
+            }
+        };
+        const size_t footerOffset = bytes.size() - kFooterSize;
+        const char* footer = bytes.data() + footerOffset;
+        const auto indexOffset = readPod<uint64_t>(footer);
+        const auto bloomOffset = readPod<uint64_t>(footer + 8);
+        recordCount_ = readPod<uint64_t>(footer + 16);
+        coversFrom_ = readPod<uint64_t>(footer + 24);
+        require(indexOffset <= bloomOffset && bloomOffset <= footerOffset);
+        records_ = bytes.substr(0, indexOffset);
+        
+        constexpr size_t kEntryOverhead = sizeof(uint32_t) + sizeof(uint64_t);
+        std::string_view index = bytes.substr(indexOffset, bloomOffset - indexOffset);
+        require(index.size() >= sizeof(uint32_t));
+        const auto indexCount = readPod<uint32_t>(index.data());
+        index.remove_prefix(sizeof(uint32_t));
+        require(indexCount <= index.size() / kEntryOverhead);
+        index_.reserve(indexCount);
+        for (uint32_t i = 0; i < indexCount; ++i) {
+            require(index.size() >= kEntryOverhead);
+            const auto keyLength = readPod<uint32_t>(index.data());
+            require(keyLength <= index.size() - kEntryOverhead);
+            std::string_view key = index.substr(sizeof(uint32_t), keyLength);
+            const auto offset = readPod<uint64_t>(index.data() + sizeof(uint32_t) + keyLength);
+            require(offset < records_.size());
+            index_.push_back({key, offset});
+            index.remove_prefix(kEntryOverhead + keyLength);
+        }
+        
+        constexpr size_t kBloomHeader = sizeof(uint32_t) + sizeof(uint64_t);
+        std::string_view bloom = bytes.substr(bloomOffset, footerOffset - bloomOffset);
+        require(bloom.size() >= kBloomHeader);
+        bloomHashes_ = readPod<uint32_t>(bloom.data());
+        const auto bloomBytes = readPod<uint64_t>(bloom.data() + sizeof(uint32_t));
+        require(bloomBytes > 0 && bloomBytes <= bloom.size() - kBloomHeader);
+        bloom_ = bloom.substr(kBloomHeader, bloomBytes);
+    }
+    
+    Lookup find(std::string_view key, std::string_view& value) const {
+        if (index_.empty() || !bloomMayContain(bloom_, bloomHashes_, key)) {
+            return Lookup::Absent;
+        }
+        // Last sparse-index key <= key, then a short forward scan
+        auto it = std::upper_bound(index_.begin(), index_.end(), key,
+            [](std::string_view k, const IndexEntry& entry) { return k < entry.key; });
+        if (it == index_.begin()) {
+            return Lookup::Absent;
+        }
+        size_t offset = std::prev(it)->offset;
+        const size_t end = it != index_.end() ? it->offset : records_.size();
+        while (offset < end) {
+            Record record = readRecord(offset);
+            if (record.key == key) {
+                value = record.value;
+                return record.deleted ? Lookup::Deleted : Lookup::Value;
+            }
+            if (record.key > key) {
+                break;
+            }
+            offset = record.next;
+        }
+        return Lookup::Absent;
+    }
+    
+    // Visits (key, value, deleted) in key order
+    template<typename Func>
+    void forEach(Func&& func) const {
+        for (size_t offset = 0; offset < records_.size();) {
+            Record record = readRecord(offset);
+            func(record.key, record.value, record.deleted);
+            offset = record.next;
+        }
+    }
+    
+    [[nodiscard]] const std::filesystem::path& path() const noexcept { return path_; }
+    [[nodiscard]] uint64_t sequence() const noexcept { return sequence_; }
+    [[nodiscard]] uint64_t coversFrom() const noexcept { return coversFrom_; }
+    [[nodiscard]] uint64_t recordCount() const noexcept { return recordCount_; }
+
+private:
+    friend class SegmentCursor;
+    
+    struct IndexEntry {
+        std::string_view key;
+        uint64_t offset;
+    };
+    
+    struct Record {
+        std::string_view key;
+        std::string_view value;
+        bool deleted;
+        size_t next;
+    };
+    
+    // Records are checked lazily, as they are read, so opening stays O(index)
+    Record readRecord(size_t offset) const {
+        constexpr size_t kHeader = 2 * sizeof(uint32_t);
+        if (records_.size() - offset < kHeader) {
+            throw std::runtime_error("Corrupt segment " + path_.string());
+        }
+        const char* at = records_.data() + offset;
+        const auto keyLength = readPod<uint32_t>(at);
+        const auto valueLength = readPod<uint32_t>(at + sizeof(uint32_t));
+        const bool deleted = valueLength == kTombstone;
+        const size_t stored = deleted ? 0 : valueLength;
+        if (records_.size() - offset - kHeader < size_t{keyLength} + stored) {
+            throw std::runtime_error("Corrupt segment " + path_.string());
+        }
+        const char* key = at + 2 * sizeof(uint32_t);
+        return {{key, keyLength}, {key + keyLength, stored}, deleted,
+                offset + 2 * sizeof(uint32_t) + keyLength + stored};
+    }
+    
+    std::filesystem::path path_;
+    uint64_t sequence_;
+    MappedFile file_;
+    std::string_view records_;
+    std::vector<IndexEntry> index_;
+    std::string_view bloom_;
+    uint32_t bloomHashes_ = 0;
+    uint64_t recordCount_ = 0;
+    uint64_t coversFrom_ = 0;
+};
+
+// Forward iterator over a segment's records, used by the compaction merge
+class SegmentCursor {
+public:
+    explicit SegmentCursor(const Segment& segment) : segment_(&segment) {
+        advance();
+    }
+    
+    [[nodiscard]] bool valid() const noexcept { return valid_; }
+    [[nodiscard]] std::string_view key() const noexcept { return record_.key; }
+    [[nodiscard]] std::string_view value() const noexcept { return record_.value; }
+    [[nodiscard]] bool deleted() const noexcept { return record_.deleted; }
+    
+    void advance() {
+        valid_ = offset_ < segment_->records_.size();
+        if (valid_) {
+            record_ = segment_->readRecord(offset_);
+            offset_ = record_.next;
+        }
+    }
+
+private:
+    const Segment* segment_;
+    Segment::Record record_{};
+    size_t offset_ = 0;
+    bool valid_ = false;
+};
+
+// Streams sorted records into <path>.tmp, then renames it into place
+class SegmentWriter {
+public:
+    SegmentWriter(std::filesystem::path path, size_t expectedKeys,
+                  size_t indexInterval, size_t bloomBitsPerKey)
+        : path_(std::move(path)), tempPath_(path_.string() + ".tmp"),
+          indexInterval_(std::max<size_t>(1, indexInterval)) {
+        file_ = std::fopen(tempPath_.string().c_str(), "wb");
+        if (!file_) {
+            throw std::runtime_error("Cannot create " + tempPath_.string());
+        }
+        std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+        size_t bloomBits = std::max<size_t>(64, expectedKeys * bloomBitsPerKey);
+        bloom_.assign((bloomBits + 7) / 8, '\0');
+        // k = bits-per-key * ln 2 minimises the false-positive rate
+        bloomHashes_ = static_cast<uint32_t>(std::clamp<size_t>(bloomBitsPerKey * 69 / 100, 1, 30));
+    }
+    
+    ~SegmentWriter() {
+        if (file_) {
+            std::fclose(file_);
+            std::error_code ignored;
+            std::filesystem::remove(tempPath_, ignored);
+        }
+    }
+    
+    SegmentWriter(const SegmentWriter&) = delete;
+    SegmentWriter& operator=(const SegmentWriter&) = delete;
+    
+    void add(std::string_view key, std::string_view value, bool deleted) {
+        if (records_ % indexInterval_ == 0) {
+            appendPod(index_, static_cast<uint32_t>(key.size()));
+            index_.append(key);
+            appendPod(index_, offset_);
+            ++indexCount_;
+        }
+        bloomAdd(bloom_, bloomHashes_, key);
+        
+        const uint32_t header[2] = {static_cast<uint32_t>(key.size()),
+                                    deleted ? kTombstone : static_cast<uint32_t>(value.size())};
+        write(header, sizeof(header));
+        write(key.data(), key.size());
+        if (!deleted) {
+            write(value.data(), value.size());
+        }
+        ++records_;
+    }
+    
+    // Writes index, bloom filter and footer, syncs and publishes the file;
+    // the directory is synced too, so the segment survives a crash before
+    // the caller truncates the log it replaces
+    void finish(uint64_t coversFrom) {
+        std::string tail;
+        appendPod(tail, indexCount_);
+        tail += index_;
+        const uint64_t bloomOffset = offset_ + tail.size();
+        appendPod(tail, bloomHashes_);
+        appendPod(tail, static_cast<uint64_t>(bloom_.size()));
+        tail += bloom_;
+        appendPod(tail, offset_);
+        appendPod(tail, bloomOffset);
+        appendPod(tail, records_);
+        appendPod(tail, coversFrom);
+        appendPod(tail, kSegmentMagic);
+        write(tail.data(), tail.size());
+        
+        bool ok = std::fflush(file_) == 0;
+#if YAGNI_HAS_POSIX_IO
+        ok = ok && ::fsync(::fileno(file_)) == 0;
+#endif
+        ok = std::fclose(file_) == 0 && ok;
+        file_ = nullptr;
+        if (!ok) {
+            throw std::runtime_error("Cannot write " + tempPath_.string());
+        }
+        std::filesystem::rename(tempPath_, path_);
+        syncDirectory(path_.parent_path());
+    }
+
+private:
+    void write(const void* data, size_t size) {
+        if (std::fwrite(data, 1, size, file_) != size) {
+            throw std::runtime_error("Cannot write " + tempPath_.string());
+        }
+        offset_ += size;
+    }
+    
+    std::filesystem::path path_;
+    std::filesystem::path tempPath_;
+    std::FILE* file_ = nullptr;
+    size_t indexInterval_;
+    uint64_t offset_ = 0;
+    uint64_t records_ = 0;
+    uint32_t indexCount_ = 0;
+    std::string index_;
+    std::string bloom_;
+    uint32_t bloomHashes_ = 1;
+};
+
+using SegmentList = std::vector<std::shared_ptr<const Segment>>; // newest first
+
+} // namespace kv_detail
+
+class LogStructuredStore {
+public:
+    struct Options {
+        size_t memtableBytes = 4 << 20;  // flush threshold (keys + values)
+        size_t indexInterval = 16;       // one sparse-index entry per N records
+        size_t bloomBitsPerKey = 10;     // ~1% false positives
+        size_t compactionTrigger = 4;    // segment count that starts a merge (>= 2)
+        bool syncWrites = false;         // fsync the log on every save/remove
+    };
+    
+    struct Stats {
+        size_t segments = 0;
+        size_t memtableEntries = 0;
+        size_t walRecordsReplayed = 0;
+        size_t flushes = 0;
+        size_t compactions = 0;
+    };
+    
+    // Pins a set of segments; views from load() live as long as the snapshot
+    class Snapshot {
+    public:
+        [[nodiscard]] std::optional<std::string_view> load(std::string_view key) const {
+            return LogStructuredStore::loadFrom(*segments_, key);
+        }
+        
+        [[nodiscard]] size_t segmentCount() const noexcept {
+            return segments_->size();
+        }
+
+    private:
+        friend class LogStructuredStore;
+        explicit Snapshot(std::shared_ptr<const kv_detail::SegmentList> segments)
+            : segments_(std::move(segments)) {}
+        
+        std::shared_ptr<const kv_detail::SegmentList> segments_;
+    };
+    
+    explicit LogStructuredStore(std::filesystem::path directory)
+        : LogStructuredStore(std::move(directory), Options{}) {}
+    
+    LogStructuredStore(std::filesystem::path directory, Options options)
+        : directory_(std::move(directory)), options_(options),
+          segments_(std::make_shared<const kv_detail::SegmentList>()) {
+        // A merge leaves one segment behind, so a trigger of 1 would restart forever
+        if (options_.compactionTrigger < 2) {
+            throw std::invalid_argument("LogStructuredStore requires compactionTrigger >= 2");
+        }
+        std::filesystem::create_directories(directory_);
+        recoverSegments();
+        replayWal();
+    }
+    
+    ~LogStructuredStore() {
+        closing_ = true;
+        try {
+            waitForCompaction();
+        } catch (const std::exception& e) {
+            std::cerr << "Compaction failed: " << e.what() << std::endl;
+        }
+        if (wal_) {
+            std::fclose(wal_);
+        }
+    }
+    
+    LogStructuredStore(const LogStructuredStore&) = delete;
+    LogStructuredStore& operator=(const LogStructuredStore&) = delete;
+    
+    void save(std::string_view key, std::string_view value) {
+        apply(kv_detail::kWalPut, key, value);
+    }
+    
+    void remove(std::string_view key) {
+        apply(kv_detail::kWalRemove, key, {});
+    }
+    
+    // Zero-copy; the view is valid until the next non-const call on the store
+    [[nodiscard]] std::optional<std::string_view> load(std::string_view key) const {
+        auto it = memtable_.find(key);
+        if (it != memtable_.end()) {
+            if (it->second->deleted) {
+                return std::nullopt;
+            }
+            return std::string_view(it->second->value);
+        }
+        return loadFrom(*segments_, key);
+    }
+    
+    [[nodiscard]] bool exists(std::string_view key) const {
+        return load(key).has_value();
+    }
+    
+    // Writes the memtable out as a segment and truncates the log
+    void flush() {
+        installCompaction();
+        if (memtable_.empty()) {
+            return;
+        }
+        std::vector<const MemEntry*> entries;
+        entries.reserve(memtable_.size());
+        for (const auto& [key, entry] : memtable_) {
+            entries.push_back(entry.get());
+        }
+        std::sort(entries.begin(), entries.end(),
+            [](const MemEntry* a, const MemEntry* b) { return a->key < b->key; });
+        
+        const uint64_t sequence = nextSequence_++;
+        {
+            kv_detail::SegmentWriter writer(segmentPath(sequence), entries.size(),
+                                            options_.indexInterval, options_.bloomBitsPerKey);
+            for (const MemEntry* entry : entries) {
+                writer.add(entry->key, entry->value, entry->deleted);
+            }
+            writer.finish(sequence);
+        }
+        auto segments = std::make_shared<kv_detail::SegmentList>();
+        segments->reserve(segments_->size() + 1);
+        segments->push_back(std::make_shared<const kv_detail::Segment>(segmentPath(sequence), sequence));
+        segments->insert(segments->end(), segments_->begin(), segments_->end());
+        segments_ = std::move(segments);
+        
+        memtable_.clear();
+        memtableBytes_ = 0;
+        openWal("wb");
+        ++stats_.flushes;
+        maybeStartCompaction();
+    }
+    
+    // Flushes the memtable so the snapshot covers every write so far
+    [[nodiscard]] Snapshot snapshot() {
+        flush();
+        return Snapshot(segments_);
+    }
+    
+    // Blocks until no compaction is running and installs every result;
+    // installing one can start the next, so this drains the whole chain
+    void waitForCompaction() {
+        while (compactor_.joinable()) {
+            compactor_.join();
+            installCompaction();
+        }
+    }
+    
+    [[nodiscard]] Stats stats() const {
+        Stats stats = stats_;
+        stats.segments = segments_->size();
+        stats.memtableEntries = memtable_.size();
+        return stats;
+    }
+
+private:
+    struct MemEntry {
+        std::string key;
+        std::string value;
+        bool deleted = false;
+    };
+    
+    static std::optional<std::string_view> loadFrom(const kv_detail::SegmentList& segments,
+                                                    std::string_view key) {
+        std::string_view value;
+        for (const auto& segment : segments) {
+            switch (segment->find(key, value)) {
+            case kv_detail::Segment::Lookup::Value:
+                return value;
+            case kv_detail::Segment::Lookup::Deleted:
+                return std::nullopt;
+            case kv_detail::Segment::Lookup::Absent:
+                break;
+            }
+        }
+        return std::nullopt;
+    }
+    
+    std::filesystem::path segmentPath(uint64_t sequence) const {
+        char name[40];
+        std::snprintf(name, sizeof(name), "segment-%016llu.sst", static_cast<unsigned long long>(sequence));
+        return directory_ / name;
+    }
+    
+    std::filesystem::path walPath() const {
+        return directory_ / "wal.log";
+    }
+    
+    void apply(uint8_t op, std::string_view key, std::string_view value) {
+        installCompaction();
+        appendWal(op, key, value);
+        applyToMemtable(op, key, value);
+        if (memtableBytes_ >= options_.memtableBytes) {
+            flush();
+        }
+    }
+    
+    // Log record: [u32 checksum][u8 op][u32 keyLen][u32 valueLen][key][value]
+    void appendWal(uint8_t op, std::string_view key, std::string_view value) {
+        walRecord_.clear();
+        walRecord_.push_back(static_cast<char>(op));
+        kv_detail::appendPod(walRecord_, static_cast<uint32_t>(key.size()));
+        kv_detail::appendPod(walRecord_, static_cast<uint32_t>(value.size()));
+        walRecord_.append(key);
+        walRecord_.append(value);
+        const auto checksum = static_cast<uint32_t>(kv_detail::fnv1a(walRecord_));
+        if (std::fwrite(&checksum, sizeof(checksum), 1, wal_) != 1 ||
+            std::fwrite(walRecord_.data(), 1, walRecord_.size(), wal_) != walRecord_.size()) {
+            throw std::runtime_error("Cannot append to " + walPath().string());
+        }
+        if (options_.syncWrites) {
+            bool ok = std::fflush(wal_) == 0;
+#if YAGNI_HAS_POSIX_IO
+            ok = ok && ::fsync(::fileno(wal_)) == 0;
+#endif
+            if (!ok) {
+                throw std::runtime_error("Cannot sync " + walPath().string());
+            }
+        }
+    }
+    
+    void openWal(const char* mode) {
+        if (wal_) {
+            std::fclose(wal_);
+        }
+        wal_ = std::fopen(walPath().string().c_str(), mode);
+        if (!wal_) {
+            throw std::runtime_error("Cannot open " + walPath().string());
+        }
+        std::setvbuf(wal_, nullptr, _IOFBF, 1 << 16);
+    }
+    
+    void recoverSegments() {
+        std::vector<std::pair<uint64_t, std::filesystem::path>> found;
+        for (const auto& file : std::filesystem::directory_iterator(directory_)) {
+            const std::string name = file.path().filename().string();
+            if (file.path().extension() == ".tmp") {
+                std::filesystem::remove(file.path()); // interrupted flush or merge
+            } else if (name.rfind("segment-", 0) == 0 && file.path().extension() == ".sst") {
+                found.emplace_back(std::stoull(name.substr(8)), file.path());
+            }
+        }
+        std::sort(found.begin(), found.end(),
+            [](const auto& a, const auto& b) { return a.first > b.first; });
+        
+        auto segments = std::make_shared<kv_detail::SegmentList>();
+        uint64_t staleBelow = 0; // sequences in [coversFrom, newer merge) are stale
+        uint64_t staleFrom = UINT64_MAX;
+        for (const auto& [sequence, path] : found) {
+            nextSequence_ = std::max(nextSequence_, sequence + 1);
+            if (sequence >= staleFrom && sequence < staleBelow) {
+                std::filesystem::remove(path);
+                continue;
+            }
+            auto segment = std::make_shared<const kv_detail::Segment>(path, sequence);
+            if (segment->coversFrom() < sequence) {
+                staleFrom = segment->coversFrom();
+                staleBelow = sequence;
+            }
+            segments->push_back(std::move(segment));
+        }
+        segments_ = std::move(segments);
+    }
+    
+    // Replays intact log records; a torn tail from a crash, or a record with
+    // an op this version does not know, ends the log and is cut off
+    void replayWal() {
+        size_t validBytes = 0;
+        if (std::filesystem::exists(walPath()) && std::filesystem::file_size(walPath()) > 0) {
+            kv_detail::MappedFile log(walPath());
+            std::string_view bytes = log.bytes();
+            constexpr size_t headerSize = sizeof(uint32_t) + 1 + 2 * sizeof(uint32_t);
+            while (bytes.size() - validBytes >= headerSize) {
+                const char* at = bytes.data() + validBytes;
+                const auto checksum = kv_detail::readPod<uint32_t>(at);
+                const auto op = static_cast<uint8_t>(at[4]);
+                const auto keyLength = kv_detail::readPod<uint32_t>(at + 5);
+                const auto valueLength = kv_detail::readPod<uint32_t>(at + 9);
+                const size_t recordSize = headerSize + keyLength + valueLength;
+                if (bytes.size() - validBytes < recordSize ||
+                    static_cast<uint32_t>(kv_detail::fnv1a(bytes.substr(validBytes + 4, recordSize - 4))) != checksum ||
+                    (op != kv_detail::kWalPut && op != kv_detail::kWalRemove)) {
+                    break;
+                }
+                std::string_view key(at + headerSize, keyLength);
+                std::string_view value(at + headerSize + keyLength, valueLength);
+                applyToMemtable(op, key, value);
+                validBytes += recordSize;
+                ++stats_.walRecordsReplayed;
+            }
+            if (validBytes < bytes.size()) {
+                std::filesystem::resize_file(walPath(), validBytes);
+            }
+        }
+        openWal("ab");
+    }
+    
+    void applyToMemtable(uint8_t op, std::string_view key, std::string_view value) {
+        if (op != kv_detail::kWalPut && op != kv_detail::kWalRemove) {
+            throw std::invalid_argument("Unknown log op " + std::to_string(op));
+        }
+        auto it = memtable_.find(key);
+        if (it == memtable_.end()) {
+            auto entry = std::make_unique<MemEntry>();
+            entry->key.assign(key);
+            // The map key views the entry's own string, which never moves
+            std::string_view stableKey = entry->key;
+            it = memtable_.emplace(stableKey, std::move(entry)).first;
+            memtableBytes_ += key.size();
+        }
+        MemEntry& entry = *it->second;
+        memtableBytes_ += value.size();
+        memtableBytes_ -= entry.value.size();
+        entry.value.assign(value);
+        entry.deleted = op == kv_detail::kWalRemove;
+    }
+    
+    void maybeStartCompaction() {
+        if (closing_ || compactor_.joinable() || segments_->size() < options_.compactionTrigger) {
+            return;
+        }
+        // Inputs are every segment, so nothing older can hide behind a
+        // dropped tombstone. The output takes the newest input's sequence.
+        compactionInputs_ = segments_;
+        compactionDone_.store(false, std::memory_order_relaxed);
+        compactor_ = std::thread([this, inputs = compactionInputs_] {
+            try {
+                compactionResult_ = compact(*inputs);
+            } catch (...) {
+                compactionError_ = std::current_exception();
+            }
+            compactionDone_.store(true, std::memory_order_release);
+        });
+    }
+    
+    std::shared_ptr<const kv_detail::Segment> compact(const kv_detail::SegmentList& inputs) const {
+        size_t expectedKeys = 0;
+        std::vector<kv_detail::SegmentCursor> cursors;
+        cursors.reserve(inputs.size());
+        for (const auto& segment : inputs) {
+            expectedKeys += segment->recordCount();
+            cursors.emplace_back(*segment);
+        }
+        
+        const uint64_t sequence = inputs.front()->sequence();
+        const uint64_t coversFrom = inputs.back()->coversFrom();
+        kv_detail::SegmentWriter writer(segmentPath(sequence), expectedKeys,
+                                        options_.indexInterval, options_.bloomBitsPerKey);
+        // k-way merge; cursors are newest first, so the first holder of the
+        // smallest key has its latest version
+        for (;;) {
+            const kv_detail::SegmentCursor* newest = nullptr;
+            for (const auto& cursor : cursors) {
+                if (cursor.valid() && (!newest || cursor.key() < newest->key())) {
+                    newest = &cursor;
+                }
+            }
+            if (!newest) {
+                break;
+            }
+            const std::string_view key = newest->key();
+            if (!newest->deleted()) {
+                writer.add(key, newest->value(), false);
+            }
+            for (auto& cursor : cursors) {
+                if (cursor.valid() && cursor.key() == key && &cursor != newest) {
+                    cursor.advance();
+                }
+            }
+            const_cast<kv_detail::SegmentCursor*>(newest)->advance();
+        }
+        // Replaces the newest input in place; older inputs are removed after
+        writer.finish(coversFrom);
+        for (size_t i = 1; i < inputs.size(); ++i) {
+            std::filesystem::remove(inputs[i]->path());
+        }
+        return std::make_shared<const kv_detail::Segment>(segmentPath(sequence), sequence);
+    }
+    
+    void installCompaction() {
+        if (!compactionDone_.load(std::memory_order_acquire)) {
+            return;
+        }
+        if (compactor_.joinable()) {
+            compactor_.join();
+        }
+        compactionDone_.store(false, std::memory_order_relaxed);
+        auto inputs = std::move(compactionInputs_);
+        if (compactionError_) {
+            std::rethrow_exception(std::exchange(compactionError_, nullptr));
+        }
+        // Segments flushed while merging are newer than every input
+        auto segments = std::make_shared<kv_detail::SegmentList>(
+            segments_->begin(), segments_->end() - static_cast<std::ptrdiff_t>(inputs->size()));
+        segments->push_back(std::move(compactionResult_));
+        segments_ = std::move(segments);
+        ++stats_.compactions;
+        maybeStartCompaction();
+    }
+    
+    std::filesystem::path directory_;
+    Options options_;
+    
+    std::unordered_map<std::string_view, std::unique_ptr<MemEntry>> memtable_;
+    size_t memtableBytes_ = 0;
+    std::FILE* wal_ = nullptr;
+    std::string walRecord_;
+    
+    std::shared_ptr<const kv_detail::SegmentList> segments_;
+    uint64_t nextSequence_ = 1;
+    
+    std::thread compactor_;
+    std::atomic<bool> compactionDone_{false};
+    std::shared_ptr<const kv_detail::SegmentList> compactionInputs_;
+    std::shared_ptr<const kv_detail::Segment> compactionResult_;
+    std::exception_ptr compactionError_;
+    bool closing_ = false;  // set by the destructor so no new merge starts
+    
+    Stats stats_;
+};
+
+// Typed key/value field for structured logging
+// Holds views only: string values and keys must outlive the logging call,
+// which is always true for arguments written inline at the call site.
+class LogField {
+public:
+    enum class Type : uint8_t { Int, UInt, Double, Bool, String };
+    
+    LogField(std::string_view key, bool value) : key_(key), type_(Type::Bool) { u_ = value; }
+    LogField(std::string_view key, double value) : key_(key), type_(Type::Double) { d_ = value; }
+    LogField(std::string_view key, std::string_view value) : key_(key), type_(Type::String), text_(value) {}
+    LogField(std::string_view key, const char* value) : LogField(key, std::string_view(value)) {}
+    LogField(std::string_view key, const std::string& value) : LogField(key, std::string_view(value)) {}
+    
+    template<typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+    LogField(std::string_view key, T value) : key_(key) {
+        if constexpr (std::is_signed_v<T>) {
+            type_ = Type::Int;
+            i_ = value;
+        } else {
+            type_ = Type::UInt;
+            u_ = value;
+        }
+    }
+    
+    [[nodiscard]] std::string_view key() const noexcept { return key_; }
+    [[nodiscard]] Type type() const noexcept { return type_; }
+    
+    // Appends " key=value" in logfmt style; strings are quoted and escaped
+    void appendTo(std::string& out) const {
+        out += ' ';
+        out += key_;
+        out += '=';
+        char digits[32];
+        std::to_chars_result result{digits, {}};
+        switch (type_) {
+        case Type::Int: result = std::to_chars(digits, digits + sizeof(digits), i_); break;
+        case Type::UInt: result = std::to_chars(digits, digits + sizeof(digits), u_); break;
+        case Type::Double: result = std::to_chars(digits, digits + sizeof(digits), d_); break;
+        case Type::Bool: out += u_ ? "true" : "false"; return;
+        case Type::String: appendQuoted(out, text_); return;
+        }
+        out.append(digits, result.ptr);
+    }
+    
+    static void appendQuoted(std::string& out, std::string_view text) {
+        out += '"';
+        for (char c : text) {
+            switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            default: out += c; break;
+            }
+        }
+        out += '"';
     }
 
 private:
-    std::map<std::string, std::string> data_;
+    friend class AsyncLogger;
+    LogField() = default;
+    
+    std::string_view key_;
+    Type type_ = Type::Int;
+    union {
+        int64_t i_;
+        uint64_t u_ = 0;
+        double d_;
+    };
+    std::string_view text_;
 };
 
 // Simple logger with only current requirements
@@ -217,6 +1238,462 @@ public:
     void error(const std::string& message) {
         std::cerr << "[ERROR] " << message << std::endl;
     }
+    
+    // Structured variants: fields are formatted straight into one line
+    // instead of being concatenated by the caller
+    void log(std::string_view message, std::initializer_list<LogField> fields) {
+        std::cout << format("[LOG] ", message, fields);
+    }
+    
+    void error(std::string_view message, std::initializer_list<LogField> fields) {
+        std::cerr << format("[ERROR] ", message, fields);
+    }
+
+private:
+    static const std::string& format(std::string_view prefix, std::string_view message,
+                                     std::initializer_list<LogField> fields) {
+        thread_local std::string line;
+        line.assign(prefix);
+        line += message;
+        for (const auto& field : fields) {
+            field.appendTo(line);
+        }
+        line += '\n';
+        return line;
+    }
+};
+
+// Structured asynchronous logger
+// - callers encode a binary record into their own thread's buffer (one
+//   uncontended mutex, no formatting, no shared counters)
+// - a background writer swaps each thread's buffer with a standby one,
+//   formats records as logfmt lines and writes them to the file in batches
+// - memory is bounded at two bufferBytes buffers per live logging thread; a
+//   full buffer either drops the record (counted) or blocks the caller until
+//   the writer drains it, and an exited thread's buffers are freed once the
+//   writer has drained them
+// Lines from different threads are not globally ordered; each carries its
+// own timestamp.
+class AsyncLogger {
+public:
+    enum class Level : uint8_t { Info, Error };
+    enum class OverflowPolicy { Drop, Block };
+    
+    struct Options {
+        size_t bufferBytes = 256 * 1024;
+        std::chrono::milliseconds flushInterval{50};
+        OverflowPolicy overflow = OverflowPolicy::Drop;
+    };
+    
+    struct Stats {
+        uint64_t records = 0;
+        uint64_t dropped = 0;
+        uint64_t bytesWritten = 0;  // bytes the file accepted
+        uint64_t writeErrors = 0;   // short writes and failed flushes
+        size_t threads = 0;         // threads whose buffers are still held
+    };
+    
+    explicit AsyncLogger(const std::filesystem::path& path) : AsyncLogger(path, Options{}) {}
+    
+    AsyncLogger(const std::filesystem::path& path, Options options)
+        : options_(options), id_(nextLoggerId().fetch_add(1, std::memory_order_relaxed) + 1) {
+        file_ = std::fopen(path.string().c_str(), "ab");
+        if (!file_) {
+            throw std::runtime_error("Cannot open log file " + path.string());
+        }
+        // output_ already batches writes; unbuffered, fwrite reports what
+        // actually reached the file
+        std::setvbuf(file_, nullptr, _IONBF, 0);
+        writer_ = std::thread([this] { writerLoop(); });
+    }
+    
+    // Drains every buffered record before closing the file
+    ~AsyncLogger() {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            stopping_ = true;
+        }
+        wakeCv_.notify_one();
+        writer_.join();
+        std::fclose(file_);
+    }
+    
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+    
+    void info(std::string_view message, std::initializer_list<LogField> fields = {}) {
+        log(Level::Info, message, fields);
+    }
+    
+    void error(std::string_view message, std::initializer_list<LogField> fields = {}) {
+        log(Level::Error, message, fields);
+    }
+    
+    void log(Level level, std::string_view message, std::initializer_list<LogField> fields) {
+        const uint64_t timestamp = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+        message = message.substr(0, UINT16_MAX);
+        size_t size = kHeaderSize + message.size();
+        size_t sized = 0;
+        for (const auto& field : fields) {
+            if (sized++ == UINT8_MAX) {
+                break;
+            }
+            size += encodedSize(field);
+        }
+        
+        ThreadBuffer& buffer = localBuffer();
+        std::unique_lock<std::mutex> lock(buffer.mutex);
+        if (buffer.active.size() + size > options_.bufferBytes) {
+            if (options_.overflow == OverflowPolicy::Drop || size > options_.bufferBytes) {
+                ++buffer.dropped;
+                requestDrain(buffer);
+                return;
+            }
+            requestDrain(buffer);
+            buffer.drained.wait(lock, [&] { return buffer.active.size() + size <= options_.bufferBytes; });
+        }
+        
+        const size_t offset = buffer.active.size();
+        buffer.active.resize(offset + size);
+        char* out = buffer.active.data() + offset;
+        out = put(out, static_cast<uint32_t>(size));
+        out = put(out, timestamp);
+        out = put(out, static_cast<uint8_t>(level));
+        out = put(out, static_cast<uint8_t>(std::min<size_t>(fields.size(), UINT8_MAX)));
+        out = put(out, static_cast<uint16_t>(message.size()));
+        out = putBytes(out, message);
+        size_t written = 0;
+        for (const auto& field : fields) {
+            if (written++ == UINT8_MAX) {
+                break;
+            }
+            out = encode(out, field);
+        }
+        ++buffer.records;
+        if (buffer.active.size() * 2 > options_.bufferBytes) {
+            requestDrain(buffer);
+        }
+    }
+    
+    // Blocks until every record logged before the call is in the file
+    void flush() {
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        const uint64_t target = ++flushRequested_;
+        wakeCv_.notify_one();
+        flushedCv_.wait(lock, [&] { return flushCompleted_ >= target; });
+    }
+    
+    [[nodiscard]] Stats stats() const {
+        Stats stats;
+        std::lock_guard<std::mutex> registryLock(registryMutex_);
+        stats.records = retiredRecords_;
+        stats.dropped = retiredDropped_;
+        for (const auto& buffer : buffers_) {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            stats.records += buffer->records;
+            stats.dropped += buffer->dropped;
+        }
+        stats.threads = buffers_.size();
+        stats.bytesWritten = bytesWritten_.load(std::memory_order_relaxed);
+        stats.writeErrors = writeErrors_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    // Record: [u32 size][u64 ns][u8 level][u8 fields][u16 msgLen][msg]
+    //         then per field [u8 keyLen][key][u8 type][payload]
+    static constexpr size_t kHeaderSize = 4 + 8 + 1 + 1 + 2;
+    
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::condition_variable drained;
+        std::vector<char> active;
+        std::vector<char> standby; // touched by the writer only
+        uint64_t records = 0;
+        uint64_t dropped = 0;
+        bool drainRequested = false;
+        bool threadExited = false;
+    };
+    
+    // The buffers this thread logs into, one per logger. The logger holds
+    // the only owning reference; on thread exit each live buffer is marked
+    // so the writer can free it after draining what is left.
+    class ThreadBuffers {
+    public:
+        ~ThreadBuffers() {
+            for (const auto& [loggerId, weak] : buffers_) {
+                if (auto buffer = weak.lock()) {
+                    std::lock_guard<std::mutex> lock(buffer->mutex);
+                    buffer->threadExited = true;
+                }
+            }
+        }
+        
+        ThreadBuffer* find(uint64_t loggerId) const noexcept {
+            for (const auto& [id, weak] : buffers_) {
+                if (id == loggerId) {
+                    return weak.lock().get();  // the logger keeps it alive
+                }
+            }
+            return nullptr;
+        }
+        
+        // Forgets buffers of destroyed loggers while adding the new one
+        void add(uint64_t loggerId, std::weak_ptr<ThreadBuffer> buffer) {
+            buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                          [](const auto& entry) { return entry.second.expired(); }),
+                           buffers_.end());
+            buffers_.emplace_back(loggerId, std::move(buffer));
+        }
+    
+    private:
+        std::vector<std::pair<uint64_t, std::weak_ptr<ThreadBuffer>>> buffers_;
+    };
+    
+    static std::atomic<uint64_t>& nextLoggerId() {
+        static std::atomic<uint64_t> id{0};
+        return id;
+    }
+    
+    ThreadBuffer& localBuffer() {
+        // Logger ids are never reused, so a stale cache entry cannot match
+        struct Cache {
+            uint64_t loggerId = 0;
+            ThreadBuffer* buffer = nullptr;
+        };
+        thread_local Cache cache;
+        if (cache.loggerId == id_) {
+            return *cache.buffer;
+        }
+        thread_local ThreadBuffers owned;
+        ThreadBuffer* buffer = owned.find(id_);
+        if (!buffer) {
+            auto created = std::make_shared<ThreadBuffer>();
+            created->active.reserve(options_.bufferBytes);
+            created->standby.reserve(options_.bufferBytes);
+            buffer = created.get();
+            owned.add(id_, created);
+            std::lock_guard<std::mutex> lock(registryMutex_);
+            buffers_.push_back(std::move(created));
+        }
+        cache = {id_, buffer};
+        return *buffer;
+    }
+    
+    // Called with buffer.mutex held; wakes the writer once per fill
+    void requestDrain(ThreadBuffer& buffer) {
+        if (buffer.drainRequested) {
+            return;
+        }
+        buffer.drainRequested = true;
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            wakeRequested_ = true;
+        }
+        wakeCv_.notify_one();
+    }
+    
+    static size_t encodedSize(const LogField& field) noexcept {
+        size_t size = 1 + std::min<size_t>(field.key_.size(), UINT8_MAX) + 1;
+        switch (field.type_) {
+        case LogField::Type::Bool: return size + 1;
+        case LogField::Type::String: return size + 4 + field.text_.size();
+        default: return size + 8;
+        }
+    }
+    
+    template<typename T>
+    static char* put(char* out, T value) noexcept {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    }
+    
+    static char* putBytes(char* out, std::string_view bytes) noexcept {
+        std::memcpy(out, bytes.data(), bytes.size());
+        return out + bytes.size();
+    }
+    
+    static char* encode(char* out, const LogField& field) noexcept {
+        std::string_view key = field.key_.substr(0, UINT8_MAX);
+        out = put(out, static_cast<uint8_t>(key.size()));
+        out = putBytes(out, key);
+        out = put(out, static_cast<uint8_t>(field.type_));
+        switch (field.type_) {
+        case LogField::Type::Bool: return put(out, static_cast<uint8_t>(field.u_ != 0));
+        case LogField::Type::String:
+            out = put(out, static_cast<uint32_t>(field.text_.size()));
+            return putBytes(out, field.text_);
+        case LogField::Type::Int: return put(out, field.i_);
+        case LogField::Type::UInt: return put(out, field.u_);
+        case LogField::Type::Double: return put(out, field.d_);
+        }
+        return out;
+    }
+    
+    // Formats one buffer's records as logfmt lines
+    static void format(const std::vector<char>& records, std::string& out) {
+        const char* at = records.data();
+        const char* end = at + records.size();
+        while (at < end) {
+            const char* next = at + get<uint32_t>(at);
+            const auto timestamp = get<uint64_t>(at + 4);
+            const auto level = static_cast<Level>(at[12]);
+            const auto fieldCount = static_cast<uint8_t>(at[13]);
+            const auto messageLength = get<uint16_t>(at + 14);
+            at += kHeaderSize;
+            
+            char digits[24];
+            out += "ts=";
+            out.append(digits, std::to_chars(digits, digits + sizeof(digits), timestamp / 1'000'000'000).ptr);
+            out += '.';
+            auto nanos = std::to_chars(digits, digits + sizeof(digits), timestamp % 1'000'000'000).ptr;
+            out.append(9 - static_cast<size_t>(nanos - digits), '0');
+            out.append(digits, nanos);
+            out += level == Level::Error ? " level=error msg=" : " level=info msg=";
+            LogField::appendQuoted(out, std::string_view(at, messageLength));
+            at += messageLength;
+            
+            for (uint8_t i = 0; i < fieldCount; ++i) {
+                LogField field;
+                const auto keyLength = static_cast<uint8_t>(*at++);
+                field.key_ = std::string_view(at, keyLength);
+                at += keyLength;
+                field.type_ = static_cast<LogField::Type>(*at++);
+                switch (field.type_) {
+                case LogField::Type::Bool: field.u_ = static_cast<uint8_t>(*at++); break;
+                case LogField::Type::String: {
+                    const auto length = get<uint32_t>(at);
+                    field.text_ = std::string_view(at + 4, length);
+                    at += 4 + length;
+                    break;
+                }
+                case LogField::Type::Int: field.i_ = get<int64_t>(at); at += 8; break;
+                case LogField::Type::UInt: field.u_ = get<uint64_t>(at); at += 8; break;
+                case LogField::Type::Double: field.d_ = get<double>(at); at += 8; break;
+                }
+                field.appendTo(out);
+            }
+            out += '\n';
+            at = next;
+        }
+    }
+    
+    template<typename T>
+    static T get(const char* at) noexcept {
+        T value;
+        std::memcpy(&value, at, sizeof(T));
+        return value;
+    }
+    
+    void drainAll() {
+        std::vector<ThreadBuffer*> buffers;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex_);
+            buffers.reserve(buffers_.size());
+            for (const auto& buffer : buffers_) {
+                buffers.push_back(buffer.get());
+            }
+        }
+        bool anyExited = false;
+        for (ThreadBuffer* buffer : buffers) {
+            {
+                std::lock_guard<std::mutex> lock(buffer->mutex);
+                buffer->drainRequested = false;
+                anyExited = anyExited || buffer->threadExited;
+                if (buffer->active.empty()) {
+                    continue;
+                }
+                std::swap(buffer->active, buffer->standby);
+            }
+            buffer->drained.notify_all();
+            format(buffer->standby, output_);
+            buffer->standby.clear();
+            if (output_.size() >= kWriteBatch) {
+                writeOutput();
+            }
+        }
+        writeOutput();
+        if (std::fflush(file_) != 0) {
+            writeErrors_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (anyExited) {
+            reclaimExited();
+        }
+    }
+    
+    // An exited thread can no longer log, so once its buffer is empty the
+    // counts move into the retired totals and the buffer is freed
+    void reclaimExited() {
+        std::lock_guard<std::mutex> registryLock(registryMutex_);
+        auto exited = std::remove_if(buffers_.begin(), buffers_.end(), [this](const auto& buffer) {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            if (!buffer->threadExited || !buffer->active.empty()) {
+                return false;
+            }
+            retiredRecords_ += buffer->records;
+            retiredDropped_ += buffer->dropped;
+            return true;
+        });
+        buffers_.erase(exited, buffers_.end());
+    }
+    
+    // A short write loses the rest of the batch; only accepted bytes count
+    void writeOutput() {
+        if (!output_.empty()) {
+            const size_t written = std::fwrite(output_.data(), 1, output_.size(), file_);
+            bytesWritten_.fetch_add(written, std::memory_order_relaxed);
+            if (written != output_.size()) {
+                writeErrors_.fetch_add(1, std::memory_order_relaxed);
+            }
+            output_.clear();
+        }
+    }
+    
+    void writerLoop() {
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        for (;;) {
+            wakeCv_.wait_for(lock, options_.flushInterval, [this] {
+                return stopping_ || wakeRequested_ || flushRequested_ != flushCompleted_;
+            });
+            const bool stopping = stopping_;
+            const uint64_t target = flushRequested_;
+            wakeRequested_ = false;
+            lock.unlock();
+            drainAll();
+            lock.lock();
+            flushCompleted_ = target;
+            flushedCv_.notify_all();
+            if (stopping) {
+                return;
+            }
+        }
+    }
+    
+    static constexpr size_t kWriteBatch = 256 * 1024;
+    
+    Options options_;
+    const uint64_t id_;
+    std::FILE* file_ = nullptr;
+    
+    mutable std::mutex registryMutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+    uint64_t retiredRecords_ = 0;  // counts of reclaimed buffers
+    uint64_t retiredDropped_ = 0;
+    
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
+    std::condition_variable flushedCv_;
+    bool wakeRequested_ = false;
+    bool stopping_ = false;
+    uint64_t flushRequested_ = 0;
+    uint64_t flushCompleted_ = 0;
+    
+    std::string output_;
+    std::atomic<uint64_t> bytesWritten_{0};
+    std::atomic<uint64_t> writeErrors_{0};
+    std::thread writer_;
 };
 
 // Simple application with only current requirements
@@ -237,15 +1714,15 @@ public:
         
         // Find a user
         if (const auto* user = userManager_.findUser("alice@example.com")) {
-            logger_.log("Found user: " + user->getName());
+            logger_.log("Found user", {{"name", user->getName()}});
         }
         
         // Display user count
-        logger_.log("Total users: " + std::to_string(userManager_.getUserCount()));
+        logger_.log("Total users", {{"count", userManager_.getUserCount()}});
         
         // List all users
         userManager_.forEachUser([this](const SimpleUser& user) {
-            logger_.log("User: " + user.getName() + " (" + user.getEmail() + ")");
+            logger_.log("User", {{"name", user.getName()}, {"email", user.getEmail()}});
         });
         
         logger_.log("Application completed");
@@ -274,24 +1751,164 @@ private:
     std::string role_;
 };
 
+// Storage policies for ExtensibleUserManager
+// Each is a single-parameter template providing add(T&&) -> T&,
+// forEach(func), size() and reserve(n). A policy that can adopt a caller's
+// object also provides add(std::unique_ptr<T>) -> T&.
+//
+// HeapStorage     - one heap block per user (the original layout); adopts a
+//                   caller's unique_ptr as is, so derived users keep their type
+// VectorStorage   - users packed in one vector; densest, but references are
+//                   invalidated when the vector grows
+// ChunkedStorage  - users packed in fixed-size chunks that never move, so
+//                   references stay valid; a pool that never frees, which is
+//                   all an add-only manager needs
+// The packed policies store T by value, so they offer no unique_ptr overload
+// that could slice a subclass; ExtensibleUserManager moves *user into them
+// only after checking it is exactly T.
+template<typename T>
+class HeapStorage {
+public:
+    T& add(T&& value) {
+        return add(std::make_unique<T>(std::move(value)));
+    }
+    
+    T& add(std::unique_ptr<T> owned) {
+        items_.push_back(std::move(owned));
+        return *items_.back();
+    }
+    
+    template<typename Func>
+    void forEach(Func&& func) const {
+        for (const auto& item : items_) {
+            func(*item);
+        }
+    }
+    
+    [[nodiscard]] size_t size() const noexcept { return items_.size(); }
+    void reserve(size_t count) { items_.reserve(count); }
+
+private:
+    std::vector<std::unique_ptr<T>> items_;
+};
+
+template<typename T>
+class VectorStorage {
+public:
+    T& add(T&& value) {
+        return items_.emplace_back(std::move(value));
+    }
+    
+    template<typename Func>
+    void forEach(Func&& func) const {
+        for (const auto& item : items_) {
+            func(item);
+        }
+    }
+    
+    [[nodiscard]] size_t size() const noexcept { return items_.size(); }
+    void reserve(size_t count) { items_.reserve(count); }
+
+private:
+    std::vector<T> items_;
+};
+
+template<typename T, size_t ChunkSize>
+class BasicChunkedStorage {
+public:
+    T& add(T&& value) {
+        if (chunks_.empty() || chunks_.back().size() == ChunkSize) {
+            chunks_.emplace_back().reserve(ChunkSize);
+        }
+        // Capacity is reserved up front, so emplace_back never reallocates
+        return chunks_.back().emplace_back(std::move(value));
+    }
+    
+    template<typename Func>
+    void forEach(Func&& func) const {
+        for (const auto& chunk : chunks_) {
+            for (const auto& item : chunk) {
+                func(item);
+            }
+        }
+    }
+    
+    [[nodiscard]] size_t size() const noexcept {
+        return chunks_.empty() ? 0 : (chunks_.size() - 1) * ChunkSize + chunks_.back().size();
+    }
+    
+    void reserve(size_t count) { chunks_.reserve((count + ChunkSize - 1) / ChunkSize); }
+
+private:
+    std::vector<std::vector<T>> chunks_;
+};
+
+// Single-parameter alias, so it binds to template<typename> class without
+// relying on P0522 matching of defaulted template parameters
+template<typename T>
+using ChunkedStorage = BasicChunkedStorage<T, 1024>;
+
+// True when a storage policy can adopt a std::unique_ptr<T> as is
+template<typename Storage, typename T, typename = void>
+struct AdoptsUniquePtr : std::false_type {};
+
+template<typename Storage, typename T>
+struct AdoptsUniquePtr<Storage, T,
+    std::void_t<decltype(std::declval<Storage&>().add(std::declval<std::unique_ptr<T>>()))>>
+    : std::true_type {};
+
 // Template-based extension (only when needed)
-template<typename UserType = SimpleUser>
+template<typename UserType = SimpleUser, template<typename> class Storage = HeapStorage>
 class ExtensibleUserManager {
 public:
-    void addUser(std::unique_ptr<UserType> user) {
-        if (user && user->isValid()) {
-            users_.push_back(std::move(user));
+    // Packed storage copies the user out of the pointer, which would slice a
+    // subclass: a statically derived U fails to compile, and a polymorphic
+    // user whose dynamic type differs throws std::invalid_argument
+    template<typename U, std::enable_if_t<std::is_base_of_v<UserType, U>, int> = 0>
+    void addUser(std::unique_ptr<U> user) {
+        if (!user || !user->isValid()) {
+            return;
+        }
+        if constexpr (AdoptsUniquePtr<Storage<UserType>, UserType>::value) {
+            users_.add(std::unique_ptr<UserType>(std::move(user)));
+        } else {
+            static_assert(std::is_same_v<U, UserType>,
+                          "packed storage holds UserType by value and would slice a subclass");
+            if constexpr (std::is_polymorphic_v<UserType>) {
+                if (typeid(*user) != typeid(UserType)) {
+                    throw std::invalid_argument("packed storage cannot hold a subclass of the user type");
+                }
+            }
+            users_.add(std::move(*user));
         }
     }
     
+    // Returns the stored user, or nullptr if invalid; see the storage
+    // policy for how long the pointer stays valid
+    UserType* addUser(UserType user) {
+        return user.isValid() ? &users_.add(std::move(user)) : nullptr;
+    }
+    
+    template<typename... Args>
+    UserType* emplaceUser(Args&&... args) {
+        return addUser(UserType(std::forward<Args>(args)...));
+    }
+    
     template<typename Func>
     void forEachUser(Func func) const {
-        std::for_each(users_.begin(), users_.end(),
-            [&func](const auto& user) { func(*user); });
+        users_.forEach(func);
+    }
+    
+    [[nodiscard]] size_t getUserCount() const noexcept {
+        return users_.size();
+    }
+    
+    void reserve(size_t count) {
+        users_.reserve(count);
     }
 
 private:
-    std::vector<std::unique_ptr<UserType>> users_;
+    Storage<UserType> users_;
 };
 
 int main() {
@@ -317,7 +1934,7 @@ int main() {
     // Demonstrate future extension (only when needed)
     std::cout << "\n--- Future Extension (When Needed) ---" << std::endl;
     
-    ExtensibleUserManager<ExtendedUser> extendedManager;
+    ExtensibleUserManager<ExtendedUser, ChunkedStorage> extendedManager;
     extendedManager.addUser(std::make_unique<ExtendedUser>("Admin", "admin@example.com", "admin"));
     extendedManager.addUser(std::make_unique<ExtendedUser>("User", "user@example.com", "user"));
     
@@ -327,5 +1944,400 @@ int main() {
                   << (user.isAdmin() ? " [ADMIN]" : "") << std::endl;
     });
     
+    // Indexed user manager
+    std::cout << "\n--- Indexed User Manager ---" << std::endl;
+    {
+        IndexedUserManager users;
+        users.emplaceUser("Alice", "alice@example.com");
+        users.emplaceUser("Bob", "bob@example.com");
+        users.emplaceUser("Carol", "carol@example.com");
+        bool duplicateAdded = users.emplaceUser("Alice2", "alice@example.com");
+        users.removeUser("alice@example.com");
+        
+        std::cout << "Users: " << users.getUserCount()
+                  << ", duplicate added: " << (duplicateAdded ? "Yes" : "No") << std::endl;
+        if (const auto* user = users.findUser("carol@example.com")) {
+            std::cout << "Found: " << user->getName() << std::endl;
+        }
+        users.forEachUser([](const SimpleUser& user) {
+            std::cout << "User: " << user.getName() << " (" << user.getEmail() << ")" << std::endl;
+        });
+    }
+    
+    // Session lookup benchmark: linear scans vs hash index
+    std::cout << "\n--- User Lookup Benchmark ---" << std::endl;
+    {
+        auto nsPerOp = [](auto start, size_t ops) {
+            return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                   static_cast<double>(ops);
+        };
+        // SimpleUserManager logs every add/remove; silence it while benchmarking
+        auto quietly = [](auto&& func) {
+            std::streambuf* saved = std::cout.rdbuf(nullptr);
+            func();
+            std::cout.rdbuf(saved);
+            std::cout.clear();
+        };
+        
+        for (size_t count : {1'000, 10'000, 100'000}) {
+            std::vector<std::string> emails;
+            emails.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                emails.push_back("user" + std::to_string(i) + "@example.com");
+            }
+            
+            SimpleUserManager linear;
+            IndexedUserManager indexed;
+            indexed.reserve(count);
+            quietly([&] {
+                for (size_t i = 0; i < count; ++i) {
+                    linear.addUser(std::make_unique<SimpleUser>("User" + std::to_string(i), emails[i]));
+                }
+            });
+            for (size_t i = 0; i < count; ++i) {
+                indexed.emplaceUser("User" + std::to_string(i), emails[i]);
+            }
+            
+            std::mt19937 rng(11);
+            std::uniform_int_distribution<size_t> pick(0, count - 1);
+            const size_t linearOps = std::max<size_t>(100, 10'000'000 / count);
+            const size_t indexedOps = 1'000'000;
+            size_t found = 0;
+            
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < linearOps; ++i) {
+                found += linear.findUser(emails[pick(rng)]) != nullptr;
+            }
+            double linearFindNs = nsPerOp(start, linearOps);
+            
+            start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < indexedOps; ++i) {
+                found += indexed.findUser(emails[pick(rng)]) != nullptr;
+            }
+            double indexedFindNs = nsPerOp(start, indexedOps);
+            
+            // Remove and re-add random users
+            const size_t churn = std::min<size_t>(count / 10, 1'000);
+            std::vector<size_t> victims(churn);
+            for (auto& victim : victims) {
+                victim = pick(rng);
+            }
+            start = std::chrono::steady_clock::now();
+            quietly([&] {
+                for (size_t victim : victims) {
+                    linear.removeUser(emails[victim]);
+                    linear.addUser(std::make_unique<SimpleUser>("User", emails[victim]));
+                }
+            });
+            double linearChurnNs = nsPerOp(start, churn);
+            
+            start = std::chrono::steady_clock::now();
+            for (size_t victim : victims) {
+                indexed.removeUser(emails[victim]);
+                indexed.emplaceUser("User", emails[victim]);
+            }
+            double indexedChurnNs = nsPerOp(start, churn);
+            
+            std::cout << count << " users: findUser " << linearFindNs << " -> " << indexedFindNs
+                      << " ns, remove+add " << linearChurnNs << " -> " << indexedChurnNs
+                      << " ns (found " << found << ", " << indexed.getUserCount() << " indexed)" << std::endl;
+        }
+    }
+    
+    // Data store backends: string_view lookups into tree vs flat maps
+    std::cout << "\n--- Data Store Lookup Benchmark ---" << std::endl;
+    {
+        constexpr size_t keyCount = 10'000;
+        constexpr size_t lookups = 2'000'000;
+        std::vector<std::string> keys;
+        keys.reserve(keyCount);
+        for (size_t i = 0; i < keyCount; ++i) {
+            keys.push_back("service.settings.option_" + std::to_string(i * 7919 % 100'003));
+        }
+        // Callers hold keys as views into request buffers
+        std::mt19937 rng(9);
+        std::uniform_int_distribution<size_t> pick(0, keyCount - 1);
+        std::vector<std::string_view> probes(lookups);
+        for (auto& probe : probes) {
+            probe = keys[pick(rng)];
+        }
+        auto report = [](const char* name, size_t buildAllocations, auto start, size_t lookupAllocations, size_t found) {
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / lookups;
+            std::cout << name << ": build " << buildAllocations << " allocations, lookup " << ns << " ns, "
+                      << static_cast<double>(lookupAllocations) / lookups << " allocations/lookup (found " << found << ")"
+                      << std::endl;
+        };
+        
+        // Previous interface: std::map<std::string, ...> searched with a std::string key.
+        // Each container allocates from its own CountingResource, so the counts
+        // cover exactly its nodes, tables and keys (including probe keys).
+        {
+            CountingResource counter;
+            std::pmr::map<std::pmr::string, std::pmr::string> legacy(&counter);
+            for (const auto& key : keys) {
+                legacy[std::pmr::string(key, &counter)] = "value";
+            }
+            size_t built = counter.allocations();
+            size_t found = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (std::string_view probe : probes) {
+                found += legacy.find(std::pmr::string(probe, &counter)) != legacy.end();
+            }
+            report("std::map + std::string key", built, start, counter.allocations() - built, found);
+        }
+        
+        const std::pair<const char*, StringMapKind> kinds[] = {
+            {"Tree (transparent)", StringMapKind::Tree},
+            {"Sorted flat map", StringMapKind::Sorted},
+            {"Hash flat map", StringMapKind::Hash},
+        };
+        for (const auto& [name, kind] : kinds) {
+            CountingResource counter;
+            SimpleDataStore store(kind, &counter);
+            // save() logs every call; silence it while filling
+            std::streambuf* saved = std::cout.rdbuf(nullptr);
+            for (const auto& key : keys) {
+                store.save(key, "value");
+            }
+            std::cout.rdbuf(saved);
+            std::cout.clear();
+            size_t built = counter.allocations();
+            size_t found = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (std::string_view probe : probes) {
+                found += store.find(probe) != nullptr;
+            }
+            report(name, built, start, counter.allocations() - built, found);
+        }
+    }
+    
+    // Log-structured key-value store
+    std::cout << "\n--- Log-Structured Store ---" << std::endl;
+    const auto storeRoot = std::filesystem::temp_directory_path() /
+        ("yagni_kv_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    {
+        const auto directory = storeRoot / "demo";
+        {
+            LogStructuredStore store(directory);
+            store.save("config", "simple");
+            store.save("version", "1.0");
+            store.save("obsolete", "yes");
+            store.remove("obsolete");
+            store.flush();
+            store.save("version", "1.1");
+            auto version = store.load("version");
+            std::cout << "version = " << (version ? *version : "<missing>")
+                      << ", obsolete exists: " << (store.exists("obsolete") ? "Yes" : "No") << std::endl;
+            
+            auto snapshot = store.snapshot();
+            store.save("version", "2.0");
+            std::cout << "snapshot version = " << snapshot.load("version").value_or("<missing>")
+                      << ", live version = " << store.load("version").value_or("<missing>") << std::endl;
+        }
+        LogStructuredStore reopened(directory);
+        auto stats = reopened.stats();
+        std::cout << "After restart: version = " << reopened.load("version").value_or("<missing>")
+                  << " (" << stats.segments << " segments, "
+                  << stats.walRecordsReplayed << " log records replayed)" << std::endl;
+    }
+    
+    // Random read/write mixes and restart recovery
+    std::cout << "\n--- Log-Structured Store Benchmark ---" << std::endl;
+    {
+        constexpr size_t keyCount = 200'000;
+        constexpr size_t operations = 500'000;
+        const auto directory = storeRoot / "bench";
+        auto secondsSince = [](auto start) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+        auto keyFor = [](size_t i) { return "key" + std::to_string(i * 2654435761ULL % 1'000'000'007ULL); };
+        const std::string baseValue(100, 'v');
+        std::mt19937_64 rng(5);
+        std::uniform_int_distribution<size_t> pick(0, keyCount - 1);
+        
+        {
+            LogStructuredStore store(directory);
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < keyCount; ++i) {
+                store.save(keyFor(i), baseValue);
+            }
+            double loadSeconds = secondsSince(start);
+            std::cout << "Initial load: " << keyCount / loadSeconds << " writes/s" << std::endl;
+            
+            for (int readPercent : {95, 50}) {
+                std::vector<std::pair<bool, std::string>> ops;
+                ops.reserve(operations);
+                for (size_t i = 0; i < operations; ++i) {
+                    ops.emplace_back(static_cast<int>(rng() % 100) < readPercent, keyFor(pick(rng)));
+                }
+                size_t hits = 0;
+                size_t valueBytes = 0;
+                start = std::chrono::steady_clock::now();
+                for (const auto& [isRead, key] : ops) {
+                    if (isRead) {
+                        if (auto value = store.load(key)) {
+                            ++hits;
+                            valueBytes += value->size();
+                        }
+                    } else {
+                        store.save(key, baseValue);
+                    }
+                }
+                double seconds = secondsSince(start);
+                auto stats = store.stats();
+                std::cout << readPercent << "% reads: " << operations / seconds << " ops/s ("
+                          << hits << " hits, " << valueBytes << " bytes, " << stats.segments << " segments, "
+                          << stats.flushes << " flushes, " << stats.compactions << " compactions)" << std::endl;
+            }
+            store.waitForCompaction();
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        LogStructuredStore recovered(directory);
+        double recoverySeconds = secondsSince(start);
+        auto stats = recovered.stats();
+        std::cout << "Restart recovery: " << recoverySeconds * 1000.0 << " ms ("
+                  << stats.segments << " segments, " << stats.walRecordsReplayed << " log records replayed, "
+                  << (recovered.exists(keyFor(0)) ? "data intact" : "data missing") << ")" << std::endl;
+    }
+    std::filesystem::remove_all(storeRoot);
+    
+    // Structured asynchronous logging
+    std::cout << "\n--- Async Structured Logger ---" << std::endl;
+    const auto logDirectory = std::filesystem::temp_directory_path() /
+        ("yagni_log_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(logDirectory);
+    {
+        const auto path = logDirectory / "demo.log";
+        {
+            AsyncLogger logger(path);
+            logger.info("Application started");
+            logger.info("Found user", {{"name", "Alice"}, {"email", "alice@example.com"}, {"admin", false}});
+            logger.error("Quota exceeded", {{"used", 1.5}, {"limit", 1}, {"note", "said \"hi\""}});
+        }
+        std::ifstream log(path);
+        for (std::string line; std::getline(log, line);) {
+            // Skip the timestamp for stable output
+            std::cout << line.substr(line.find(' ') + 1) << std::endl;
+        }
+    }
+    
+    // Caller-side latency and sustained throughput
+    std::cout << "\n--- Async Logger Benchmark ---" << std::endl;
+    {
+        constexpr size_t calls = 200'000;
+        const std::string name = "Alice";
+        auto percentiles = [](std::vector<uint32_t>& samples) {
+            std::sort(samples.begin(), samples.end());
+            auto at = [&](double q) { return samples[static_cast<size_t>(q * (samples.size() - 1))]; };
+            return std::to_string(at(0.5)) + " / " + std::to_string(at(0.99)) + " / " + std::to_string(samples.back());
+        };
+        auto timeCalls = [&](auto&& call) {
+            std::vector<uint32_t> samples(calls);
+            for (size_t i = 0; i < calls; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                call(i);
+                samples[i] = static_cast<uint32_t>(std::min<int64_t>(UINT32_MAX,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+            }
+            return percentiles(samples);
+        };
+        
+        // Baseline: SimpleLogger style, string concatenation plus std::endl
+        {
+            std::ofstream out(logDirectory / "sync.log");
+            std::string result = timeCalls([&](size_t i) {
+                out << "[LOG] " << ("Found user: " + name + " request=" + std::to_string(i)) << std::endl;
+            });
+            std::cout << "Synchronous ofstream + endl, p50/p99/max ns: " << result << std::endl;
+        }
+        {
+            AsyncLogger::Options options;
+            options.overflow = AsyncLogger::OverflowPolicy::Block;
+            AsyncLogger logger(logDirectory / "async.log", options);
+            std::string result = timeCalls([&](size_t i) {
+                logger.info("Found user", {{"name", name}, {"request", i}});
+            });
+            logger.flush();
+            auto stats = logger.stats();
+            std::cout << "AsyncLogger::info, p50/p99/max ns: " << result
+                      << " (" << stats.records << " records, " << stats.dropped << " dropped)" << std::endl;
+        }
+        
+        // Sustained rate with several producers under each overflow policy;
+        // Block never drops, Drop trades lost records for producer latency
+        const size_t producers = std::max<size_t>(2, std::thread::hardware_concurrency());
+        constexpr size_t perProducer = 300'000;
+        for (auto policy : {AsyncLogger::OverflowPolicy::Block, AsyncLogger::OverflowPolicy::Drop}) {
+            AsyncLogger::Options options;
+            options.overflow = policy;
+            AsyncLogger logger(logDirectory / "sustained.log", options);
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < producers; ++t) {
+                threads.emplace_back([&logger, t] {
+                    for (size_t i = 0; i < perProducer; ++i) {
+                        logger.info("Request served", {{"thread", t}, {"request", i}, {"latency_ms", 0.25}, {"ok", true}});
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            logger.flush();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            auto stats = logger.stats();
+            std::cout << (policy == AsyncLogger::OverflowPolicy::Block ? "Block" : "Drop") << " policy, "
+                      << producers << " producers: " << static_cast<double>(stats.records) / seconds << " lines/s, "
+                      << stats.dropped << " dropped, " << stats.bytesWritten / (1024 * 1024) << " MiB written, "
+                      << stats.writeErrors << " write errors, buffer bound "
+                      << (producers * 2 * options.bufferBytes) / 1024 << " KiB, "
+                      << stats.threads << " buffer(s) held after join" << std::endl;
+        }
+    }
+    std::filesystem::remove_all(logDirectory);
+    
+    // Storage policies for ExtensibleUserManager
+    std::cout << "\n--- User Storage Policy Benchmark ---" << std::endl;
+    {
+        constexpr size_t userCount = 1'000'000;
+        constexpr int sweeps = 10;
+        auto benchmark = [&](const char* name, auto& manager) {
+            // Interleaved allocations stand in for a long-running heap
+            std::vector<std::unique_ptr<char[]>> unrelated;
+            unrelated.reserve(userCount);
+            std::mt19937 rng(17);
+            auto start = std::chrono::steady_clock::now();
+            manager.reserve(userCount);
+            for (size_t i = 0; i < userCount; ++i) {
+                std::string id = std::to_string(i);
+                manager.emplaceUser("user" + id, "user" + id + "@example.com", i % 10 == 0 ? "admin" : "user");
+                unrelated.push_back(std::make_unique<char[]>(16 + rng() % 240));
+            }
+            double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            
+            size_t admins = 0;
+            start = std::chrono::steady_clock::now();
+            for (int sweep = 0; sweep < sweeps; ++sweep) {
+                manager.forEachUser([&admins](const ExtendedUser& user) { admins += user.isAdmin(); });
+            }
+            double sweepMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / sweeps;
+            std::cout << name << ": build " << buildMs << " ms, isAdmin sweep " << sweepMs << " ms ("
+                      << admins / sweeps << " admins of " << manager.getUserCount() << ")" << std::endl;
+        };
+        {
+            ExtensibleUserManager<ExtendedUser, HeapStorage> manager;
+            benchmark("HeapStorage (unique_ptr per user)", manager);
+        }
+        {
+            ExtensibleUserManager<ExtendedUser, VectorStorage> manager;
+            benchmark("VectorStorage", manager);
+        }
+        {
+            ExtensibleUserManager<ExtendedUser, ChunkedStorage> manager;
+            benchmark("ChunkedStorage", manager);
+        }
+    }
+    
     return 0;
 } 
\ No newline at end of file
@@ -0,0 +1,371 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// Flat string-keyed associative containers shared by the optimized examples
+//
+// SortedFlatMap<V>  - keys and values in one sorted vector; binary-search
+//                     lookup, O(n) insert/erase. For read-mostly tables.
+// HashFlatMap<V>    - entries in a dense vector plus a linear-probing index of
+//                     entry numbers; O(1) lookup, insert and swap-and-pop
+//                     erase. For mixed workloads; iteration order is unspecified.
+// StringMap<V>      - std::map or one of the above, chosen at construction.
+//
+// Every lookup takes std::string_view, so callers never build a std::string
+// just to search. Pointers returned by find() are invalidated by the next
+// insert or erase. HashFlatMap also takes a precomputed hashOf(key), so
+// callers that already hashed the key (e.g. to pick a shard) hash it once.
+// Keys and tables are allocated from the std::pmr::memory_resource given at
+// construction (the default resource unless stated), so a caller can place a
+// map in an arena or count exactly what it allocates.
+
+enum class StringMapKind { Tree, Sorted, Hash };
+
+template<typename V>
+class SortedFlatMap {
+public:
+    using value_type = std::pair<std::pmr::string, V>;
+
+    explicit SortedFlatMap(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : entries_(resource) {}
+
+    [[nodiscard]] V* find(std::string_view key) noexcept {
+        auto it = lowerBound(key);
+        return it != entries_.end() && it->first == key ? &it->second : nullptr;
+    }
+
+    [[nodiscard]] const V* find(std::string_view key) const noexcept {
+        return const_cast<SortedFlatMap*>(this)->find(key);
+    }
+
+    // Returns true when the key was new
+    template<typename U>
+    bool insertOrAssign(std::string_view key, U&& value) {
+        auto it = lowerBound(key);
+        if (it != entries_.end() && it->first == key) {
+            it->second = std::forward<U>(value);
+            return false;
+        }
+        entries_.emplace(it, std::piecewise_construct, std::forward_as_tuple(key),
+                         std::forward_as_tuple(std::forward<U>(value)));
+        return true;
+    }
+
+    bool erase(std::string_view key) {
+        auto it = lowerBound(key);
+        if (it == entries_.end() || it->first != key) {
+            return false;
+        }
+        entries_.erase(it);
+        return true;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return entries_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return entries_.empty(); }
+    void reserve(size_t count) { entries_.reserve(count); }
+    void clear() noexcept { entries_.clear(); }
+
+    // Visits (key, value) in key order
+    template<typename Func>
+    void forEach(Func&& func) const {
+        for (const auto& [key, value] : entries_) {
+            func(std::string_view(key), value);
+        }
+    }
+
+private:
+    typename std::pmr::vector<value_type>::iterator lowerBound(std::string_view key) noexcept {
+        return std::lower_bound(entries_.begin(), entries_.end(), key,
+            [](const value_type& entry, std::string_view k) { return std::string_view(entry.first) < k; });
+    }
+
+    std::pmr::vector<value_type> entries_;
+};
+
+template<typename V>
+class HashFlatMap {
+public:
+    explicit HashFlatMap(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : entries_(resource), index_(resource) {}
+
+    // Fibonacci mixing spreads every bit of std::hash (32-bit on some
+    // platforms) into the high bits: the index uses the top bits for the
+    // home slot and the low 32 as the slot tag
+    static uint64_t hashOf(std::string_view key) noexcept {
+        return static_cast<uint64_t>(std::hash<std::string_view>{}(key)) * 0x9E3779B97F4A7C15ull;
+    }
+
+    [[nodiscard]] V* find(std::string_view key) noexcept {
+        return find(key, hashOf(key));
+    }
+
+    [[nodiscard]] const V* find(std::string_view key) const noexcept {
+        return const_cast<HashFlatMap*>(this)->find(key);
+    }
+
+    [[nodiscard]] V* find(std::string_view key, uint64_t hash) noexcept {
+        size_t slot = findSlot(key, hash);
+        return slot != npos ? &entries_[index_[slot].entry].value : nullptr;
+    }
+
+    [[nodiscard]] const V* find(std::string_view key, uint64_t hash) const noexcept {
+        return const_cast<HashFlatMap*>(this)->find(key, hash);
+    }
+
+    // Returns true when the key was new
+    template<typename U>
+    bool insertOrAssign(std::string_view key, U&& value) {
+        return insertOrAssign(key, hashOf(key), std::forward<U>(value));
+    }
+
+    template<typename U>
+    bool insertOrAssign(std::string_view key, uint64_t hash, U&& value) {
+        size_t slot = findSlot(key, hash);
+        if (slot != npos) {
+            entries_[index_[slot].entry].value = std::forward<U>(value);
+            return false;
+        }
+        if ((entries_.size() + 1) * 4 > index_.size() * 3) {
+            rebuildIndex(std::max<size_t>(16, index_.size() * 2));
+        }
+        // Store the entry before linking it, so a throwing push_back leaves
+        // no index slot pointing past the end. The key is copied before the
+        // value is moved in, so key may view into value.
+        entries_.push_back({std::pmr::string(key, entries_.get_allocator()), std::forward<U>(value), hash});
+        insertIntoIndex(static_cast<uint32_t>(entries_.size() - 1), hash);
+        return true;
+    }
+
+    bool erase(std::string_view key) {
+        return erase(key, hashOf(key));
+    }
+
+    bool erase(std::string_view key, uint64_t hash) {
+        size_t slot = findSlot(key, hash);
+        if (slot == npos) {
+            return false;
+        }
+        const uint32_t removed = index_[slot].entry;
+        const auto last = static_cast<uint32_t>(entries_.size() - 1);
+        eraseSlot(slot);
+        if (removed != last) {
+            index_[slotOf(last)].entry = removed;
+            entries_[removed] = std::move(entries_[last]);
+        }
+        entries_.pop_back();
+        return true;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return entries_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return entries_.empty(); }
+
+    void reserve(size_t count) {
+        entries_.reserve(count);
+        size_t capacity = std::max<size_t>(16, index_.size());
+        while (count * 4 > capacity * 3) {
+            capacity *= 2;
+        }
+        if (capacity != index_.size()) {
+            rebuildIndex(capacity);
+        }
+    }
+
+    void clear() noexcept {
+        entries_.clear();
+        std::fill(index_.begin(), index_.end(), Slot{});
+    }
+
+    // Visits (key, value) in storage order
+    template<typename Func>
+    void forEach(Func&& func) const {
+        for (const auto& entry : entries_) {
+            func(std::string_view(entry.key), entry.value);
+        }
+    }
+
+private:
+    static constexpr uint32_t kEmpty = UINT32_MAX;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    struct Entry {
+        std::pmr::string key;
+        V value;
+        uint64_t hash;
+    };
+
+    struct Slot {
+        uint32_t entry = kEmpty;
+        uint32_t hashTag = 0; // low 32 bits of the hash
+    };
+
+    size_t home(uint64_t hash) const noexcept {
+        return static_cast<size_t>(hash >> indexShift_);
+    }
+
+    size_t findSlot(std::string_view key, uint64_t hash) const noexcept {
+        if (index_.empty()) {
+            return npos;
+        }
+        const size_t mask = index_.size() - 1;
+        const auto tag = static_cast<uint32_t>(hash);
+        for (size_t i = home(hash);; i = (i + 1) & mask) {
+            const Slot& slot = index_[i];
+            if (slot.entry == kEmpty) {
+                return npos;
+            }
+            if (slot.hashTag == tag && entries_[slot.entry].key == key) {
+                return i;
+            }
+        }
+    }
+
+    size_t slotOf(uint32_t entry) const noexcept {
+        const size_t mask = index_.size() - 1;
+        for (size_t i = home(entries_[entry].hash);; i = (i + 1) & mask) {
+            if (index_[i].entry == entry) {
+                return i;
+            }
+        }
+    }
+
+    void insertIntoIndex(uint32_t entry, uint64_t hash) noexcept {
+        const size_t mask = index_.size() - 1;
+        size_t i = home(hash);
+        while (index_[i].entry != kEmpty) {
+            i = (i + 1) & mask;
+        }
+        index_[i] = {entry, static_cast<uint32_t>(hash)};
+    }
+
+    // Backward-shift deletion keeps probe chains gap-free without tombstones
+    void eraseSlot(size_t hole) noexcept {
+        const size_t mask = index_.size() - 1;
+        for (size_t i = (hole + 1) & mask; index_[i].entry != kEmpty; i = (i + 1) & mask) {
+            size_t ideal = home(entries_[index_[i].entry].hash);
+            if (((i - ideal) & mask) >= ((i - hole) & mask)) {
+                index_[hole] = index_[i];
+                hole = i;
+            }
+        }
+        index_[hole] = Slot{};
+    }
+
+    void rebuildIndex(size_t capacity) {
+        index_.assign(capacity, Slot{});
+        indexShift_ = 64;
+        for (size_t bits = capacity; bits > 1; bits >>= 1) {
+            --indexShift_;
+        }
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            insertIntoIndex(static_cast<uint32_t>(i), entries_[i].hash);
+        }
+    }
+
+    std::pmr::vector<Entry> entries_;
+    std::pmr::vector<Slot> index_;
+    unsigned indexShift_ = 64; // 64 - log2(index_.size())
+};
+
+template<typename V>
+class StringMap {
+public:
+    explicit StringMap(StringMapKind kind = StringMapKind::Tree,
+                       std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+        switch (kind) {
+        case StringMapKind::Tree: map_.template emplace<Tree>(resource); break;
+        case StringMapKind::Sorted: map_.template emplace<SortedFlatMap<V>>(resource); break;
+        case StringMapKind::Hash: map_.template emplace<HashFlatMap<V>>(resource); break;
+        }
+    }
+
+    [[nodiscard]] StringMapKind kind() const noexcept {
+        return static_cast<StringMapKind>(map_.index());
+    }
+
+    [[nodiscard]] const V* find(std::string_view key) const {
+        return std::visit([key](const auto& map) -> const V* {
+            if constexpr (std::is_same_v<std::decay_t<decltype(map)>, Tree>) {
+                auto it = map.find(key);
+                return it != map.end() ? &it->second : nullptr;
+            } else {
+                return map.find(key);
+            }
+        }, map_);
+    }
+
+    template<typename U>
+    bool insertOrAssign(std::string_view key, U&& value) {
+        return std::visit([&](auto& map) -> bool {
+            if constexpr (std::is_same_v<std::decay_t<decltype(map)>, Tree>) {
+                auto it = map.find(key);
+                if (it != map.end()) {
+                    it->second = std::forward<U>(value);
+                    return false;
+                }
+                map.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                            std::forward_as_tuple(std::forward<U>(value)));
+                return true;
+            } else {
+                return map.insertOrAssign(key, std::forward<U>(value));
+            }
+        }, map_);
+    }
+
+    bool erase(std::string_view key) {
+        return std::visit([key](auto& map) -> bool {
+            if constexpr (std::is_same_v<std::decay_t<decltype(map)>, Tree>) {
+                auto it = map.find(key);
+                if (it == map.end()) {
+                    return false;
+                }
+                map.erase(it);
+                return true;
+            } else {
+                return map.erase(key);
+            }
+        }, map_);
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return std::visit([](const auto& map) { return map.size(); }, map_);
+    }
+
+    void reserve(size_t count) {
+        std::visit([count](auto& map) {
+            if constexpr (!std::is_same_v<std::decay_t<decltype(map)>, Tree>) {
+                map.reserve(count);
+            }
+        }, map_);
+    }
+
+    template<typename Func>
+    void forEach(Func&& func) const {
+        std::visit([&func](const auto& map) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(map)>, Tree>) {
+                for (const auto& [key, value] : map) {
+                    func(std::string_view(key), value);
+                }
+            } else {
+                map.forEach(func);
+            }
+        }, map_);
+    }
+
+private:
+    // std::less<> makes std::map lookups transparent as well
+    using Tree = std::pmr::map<std::pmr::string, V, std::less<>>;
+
+    std::variant<Tree, SortedFlatMap<V>, HashFlatMap<V>> map_;
+};